@@ -1,3 +1,3 @@
 #!/usr/bin/zsh
 
-g++ -g -std=c++17 --output tabu-search main.cpp
\ No newline at end of file
+g++ -g -std=c++17 -pthread --output tabu-search main.cpp
\ No newline at end of file
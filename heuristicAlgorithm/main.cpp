@@ -3,21 +3,39 @@
 #include <random>
 #include <algorithm>
 #include <vector>
-#include <map>
-#include <list>
+#include <deque>
+#include <numeric>
+#include <cstdint>
+#include <new>
 #include <cstdlib>
 #include <fstream>
 #include <optional>
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <limits>
+#include <unordered_set>
+#include <unordered_map>
+#include <cmath>
+#include <chrono>
+#include <iterator>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <netdb.h>
+#include <unistd.h>
 
 using Json = nlohmann::json;
 
-struct ProblemInstance;
-
 namespace utils
 {
-    ProblemInstance *settings;
-
     enum MachineNumber
     {
         MACHINE1,
@@ -29,6 +47,161 @@ namespace utils
         OPERATION,
         MAINTENANCE
     };
+
+    enum NeighbourhoodMode
+    {
+        SAMPLED,
+        FULL,
+        CRITICAL,
+        ELITE
+    };
+
+    // What a block had to wait for before it could start
+    enum StartCause
+    {
+        TIME_ZERO,
+        PREVIOUS_OPERATION,
+        PREVIOUS_MAINTENANCE,
+        CORRESPONDING_OPERATION
+    };
+
+    // How a retry after the first one builds its initial order
+    enum RestartMode
+    {
+        RANDOM,
+        DIVERSIFY,
+        INTENSIFY,
+        ALTERNATE
+    };
+
+    enum Algorithm
+    {
+        TABU_SEARCH,
+        SIMULATED_ANNEALING,
+        GENETIC_ALGORITHM
+    };
+
+    enum CoolingSchedule
+    {
+        GEOMETRIC,
+        LINEAR,
+        LUNDY_MEES
+    };
+
+    enum MigrationTransport
+    {
+        UNIX_SOCKET,
+        TCP
+    };
+
+    // Where immigrants go: into the elite pool, or also in place of the random start of the next retries
+    enum MigrationReplacement
+    {
+        REPLACE_WORST,
+        REPLACE_RESTART
+    };
+
+    enum MoveType
+    {
+        SWAP,
+        INSERTION
+    };
+
+    // Allocates storage aligned to Alignment bytes so arrays can be read with aligned vector loads
+    template <typename T, std::size_t Alignment>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+        template <typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        AlignedAllocator() = default;
+        template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* pointer, std::size_t)
+        {
+            ::operator delete(pointer, std::align_val_t(Alignment));
+        }
+
+        template <typename U> bool operator == (const AlignedAllocator<U, Alignment> &) const { return true; }
+        template <typename U> bool operator != (const AlignedAllocator<U, Alignment> &) const { return false; }
+    };
+
+    using LengthArray = std::vector<unsigned int, AlignedAllocator<unsigned int, 64>>;
+
+    // xoshiro256++ (Blackman, Vigna), a UniformRandomBitGenerator that is much cheaper than std::mt19937.
+    // jump() advances the state by 2^128 draws, generators split off one seed with jump() never overlap.
+    class Xoshiro256PlusPlus
+    {
+        std::uint64_t state[4];
+
+        static std::uint64_t rotl(std::uint64_t x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        using result_type = std::uint64_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        explicit Xoshiro256PlusPlus(std::uint64_t seed)
+        {
+            // splitmix64 expands the seed so that close seeds give unrelated states
+            for (auto &&word : state)
+            {
+                seed += 0x9e3779b97f4a7c15;
+                std::uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        result_type operator()()
+        {
+            const std::uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+            const std::uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+            return result;
+        }
+
+        void jump()
+        {
+            static constexpr std::uint64_t polynomial[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+            jump(polynomial);
+        }
+
+        // advances the state by 2^192 draws, every long jump starts 2^64 streams apart from the jump() ones
+        void longJump()
+        {
+            static constexpr std::uint64_t polynomial[] = { 0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635 };
+            jump(polynomial);
+        }
+
+    private:
+        void jump(const std::uint64_t (&polynomial)[4])
+        {
+            std::uint64_t jumped[4] = { 0, 0, 0, 0 };
+            for (auto &&word : polynomial)
+                for (int bit = 0; bit < 64; ++bit)
+                {
+                    if(word & (std::uint64_t(1) << bit))
+                        for (int i = 0; i < 4; ++i) jumped[i] ^= state[i];
+                    (*this)();
+                }
+            std::copy(jumped, jumped + 4, state);
+        }
+    };
 }
 
 struct Task
@@ -36,12 +209,30 @@ struct Task
     unsigned int taskNumber = 0;
     unsigned int machine1OperationLength = 0;
     unsigned int machine2OperationLength = 0;
-    std::map<utils::MachineNumber, unsigned int> machineLengthMap = { {utils::MACHINE1, machine1OperationLength}, {utils::MACHINE2, machine2OperationLength} };
 
     Task(const unsigned int taskNumber, const unsigned int machine1OperationLength, const unsigned int machine2OperationLength)
     :taskNumber(taskNumber), machine1OperationLength(machine1OperationLength), machine2OperationLength(machine2OperationLength) {}
 };
 
+struct MachineBlock
+{
+    unsigned int start = 0;
+    unsigned int length = 0;
+    unsigned int end = 0;
+    unsigned int taskNumber = 0;
+    utils::MachineNumber machineNumber;    
+    utils::BlockType blockType;
+    utils::StartCause startCause = utils::TIME_ZERO;
+    
+    friend bool operator == (MachineBlock x, MachineBlock y)
+    {
+        return x.start == y.start && x.length == y.length && x.end == y.end && x.taskNumber == y.taskNumber && x.machineNumber == y.machineNumber && x.blockType == y.blockType;
+    }
+};
+
+using BlockIndex = std::uint32_t;
+using BlockOrder = std::vector<BlockIndex>;
+
 struct ProblemInstance
 {
     unsigned int maintenanceLength;
@@ -50,43 +241,206 @@ struct ProblemInstance
     unsigned int algorithmRetries;
     unsigned int candidateListSize = 5;
     unsigned int tabuListSize = 4;
+    // adapt the tabu tenure to repetitions of visited solutions instead of keeping it at tabuListSize
+    bool reactiveTabu = false;
+    utils::RestartMode restartMode = utils::RANDOM;
+    // best orders kept across retries for path relinking, 0 disables both
+    unsigned int elitePoolSize = 0;
+    utils::Algorithm algorithm = utils::TABU_SEARCH;
+    // simulated annealing cools from initialTemperature (0 estimates one from random swaps) to finalTemperature in annealingSteps
+    utils::CoolingSchedule coolingSchedule = utils::GEOMETRIC;
+    float initialTemperature = 0;
+    float finalTemperature = 0.1;
+    unsigned int annealingSteps = 100000;
+    // genetic algorithm: generations per retry, ignored when there is a time limit, and the chance that a child is mutated
+    unsigned int populationSize = 100;
+    unsigned int generations = 1000;
+    float mutationRate = 0.2;
+    // island model: islandCount processes started with ids 0 to islandCount - 1 send their best orders to the next island
+    // every migrationInterval retries. migrationAddress is a socket path prefix or host:port, empty picks a local default
+    unsigned int islandCount = 1;
+    unsigned int islandId = 0;
+    utils::MigrationTransport migrationTransport = utils::UNIX_SOCKET;
+    std::string migrationAddress;
+    unsigned int migrationInterval = 1;
+    unsigned int migrationCount = 1;
+    utils::MigrationReplacement migrationReplacement = utils::REPLACE_WORST;
+    unsigned int threads = 1;
+    utils::NeighbourhoodMode neighbourhoodMode = utils::SAMPLED;
+    unsigned int insertionSearchCount = 0;
+    // the local search stops once the standard deviation of the last convergenceWindow Cmax values drops to the threshold
+    unsigned int convergenceWindow = 300;
+    float convergenceThreshold = 1;
+    // with a time limit restarts run until it passes instead of algorithmRetries times, 0 disables it
+    unsigned int timeLimitMs = 0;
+    // runs with the same seed and a single retry thread are identical, a random one is drawn when it is not given
+    std::optional<std::uint64_t> seed;
     float operationRenewPunishmentFactor;
     std::vector<Task> tasks;
+    // operationLengths[machineNumber][i] is the length of the operation of tasks[i] on that machine
+    utils::LengthArray operationLengths[2];
+    // every operation of the instance, tasks[i] owns blocks 2i (machine 1) and 2i + 1 (machine 2)
+    std::vector<MachineBlock> blocks;
+    // taskNumber -> position in tasks
+    std::vector<unsigned int> taskPositions;
 
-    ProblemInstance(unsigned int maintenanceLength, unsigned int maintenancePeriod, unsigned int neighbourSearchCount, unsigned int algorithmRetries, float operationRenewPunishmentFactor, const std::vector<Task> &tasks)
-    :maintenanceLength(maintenanceLength), maintenancePeriod(maintenancePeriod), neighbourSearchCount(neighbourSearchCount), algorithmRetries(algorithmRetries), tasks(tasks)
+    ProblemInstance(unsigned int maintenanceLength, unsigned int maintenancePeriod, unsigned int neighbourSearchCount, unsigned int algorithmRetries, float operationRenewPunishmentFactor, std::vector<Task> tasks)
+    :maintenanceLength(maintenanceLength), maintenancePeriod(maintenancePeriod), neighbourSearchCount(neighbourSearchCount), algorithmRetries(algorithmRetries), tasks(std::move(tasks))
     {
         assert( 0 < operationRenewPunishmentFactor && operationRenewPunishmentFactor < 1 );
         this->operationRenewPunishmentFactor = operationRenewPunishmentFactor;
+
+        operationLengths[utils::MACHINE1].resize(this->tasks.size());
+        operationLengths[utils::MACHINE2].resize(this->tasks.size());
+        for (unsigned int position = 0; position < this->tasks.size(); ++position)
+        {
+            operationLengths[utils::MACHINE1][position] = this->tasks[position].machine1OperationLength;
+            operationLengths[utils::MACHINE2][position] = this->tasks[position].machine2OperationLength;
+        }
+
+        blocks.reserve(this->tasks.size() * 2);
+        for (unsigned int position = 0; position < this->tasks.size(); ++position)
+        {
+            const Task &task = this->tasks[position];
+            MachineBlock block1, block2;
+            block1.blockType = utils::OPERATION;
+            block1.machineNumber = utils::MACHINE1;
+            block1.length = operationLengths[utils::MACHINE1][position];
+            block1.taskNumber = task.taskNumber;
+
+            block2.blockType = utils::OPERATION;
+            block2.machineNumber = utils::MACHINE2;
+            block2.length = operationLengths[utils::MACHINE2][position];
+            block2.taskNumber = task.taskNumber;
+
+            blocks.push_back(block1);
+            blocks.push_back(block2);
+            if(task.taskNumber >= taskPositions.size()) taskPositions.resize(task.taskNumber + 1);
+            taskPositions[task.taskNumber] = position;
+        }
+    }
+
+    BlockIndex getBlockIndex(const MachineBlock &operation) const
+    {
+        return getBlockIndex(taskPositions[operation.taskNumber], operation.machineNumber);
+    }
+
+    BlockIndex getBlockIndex(unsigned int taskPosition, utils::MachineNumber machineNumber) const
+    {
+        return 2 * taskPosition + machineNumber;
     }
 };
 
-struct MachineBlock
+// pair of blocks on the same machine exchanging their positions in an order
+using BlockSwap = std::pair<BlockIndex, BlockIndex>;
+
+// SWAP exchanges blocks `block` and `target` of one machine, INSERTION moves `block` to position `target` of the order
+struct Move
 {
-    unsigned int start = 0;
-    unsigned int length = 0;
-    unsigned int end = 0;
-    unsigned int taskNumber = 0;
-    utils::MachineNumber machineNumber;    
-    utils::BlockType blockType;
-    
-    friend bool operator == (MachineBlock x, MachineBlock y)
+    utils::MoveType type = utils::SWAP;
+    BlockIndex block = 0;
+    std::uint32_t target = 0;
+
+    static Move fromSwap(const BlockSwap &swap)
     {
-        return x.start == y.start && x.length == y.length && x.end == y.end && x.taskNumber == y.taskNumber && x.machineNumber == y.machineNumber && x.blockType == y.blockType;
+        return {utils::SWAP, swap.first, swap.second};
+    }
+
+    static Move fromInsertion(BlockIndex block, unsigned int position)
+    {
+        return {utils::INSERTION, block, position};
     }
+
+    // a swap is the same move whichever of its blocks comes first
+    bool operator==(const Move &other) const
+    {
+        if(type != other.type) return false;
+        if(type == utils::SWAP) return std::minmax(block, target) == std::minmax(other.block, other.target);
+        return block == other.block && target == other.target;
+    }
+};
+
+struct MachineTail
+{
+    unsigned int lastOperationEnd = 0;
+    unsigned int lastMaintenanceEnd = 0;
+};
+
+// Decoder state before a given position of an order: enough to resume decoding from there
+struct DecodeCheckpoint
+{
+    unsigned int machine1Size = 0;
+    unsigned int machine2Size = 0;
+    MachineTail machine1Tail;
+    MachineTail machine2Tail;
+    unsigned int cMax = 0;
 };
 
 struct Solution
 {
     std::vector<MachineBlock> machine1;
     std::vector<MachineBlock> machine2;
+    MachineTail machine1Tail;
+    MachineTail machine2Tail;
+    unsigned int cMax = 0;
+    // taskNumber -> index of the task's operation in machine1/machine2, NO_SLOT if not placed yet
+    std::vector<int> machine1TaskSlots;
+    std::vector<int> machine2TaskSlots;
+    static constexpr int NO_SLOT = -1;
+    const ProblemInstance* settings;
+
+    Solution(const ProblemInstance &settings):settings(&settings){}
 
     std::vector<MachineBlock>* getMachine(utils::MachineNumber machineNumber)
     {
        return machineNumber == utils::MACHINE1 ?  &machine1 : &machine2;
     }
 
-    std::string toString()
+    MachineTail* getMachineTail(utils::MachineNumber machineNumber)
+    {
+       return machineNumber == utils::MACHINE1 ?  &machine1Tail : &machine2Tail;
+    }
+
+    std::vector<int>* getMachineTaskSlots(utils::MachineNumber machineNumber)
+    {
+       return machineNumber == utils::MACHINE1 ?  &machine1TaskSlots : &machine2TaskSlots;
+    }
+
+    void clear()
+    {
+        machine1.clear();
+        machine2.clear();
+        machine1Tail = MachineTail();
+        machine2Tail = MachineTail();
+        cMax = 0;
+        std::fill(machine1TaskSlots.begin(), machine1TaskSlots.end(), NO_SLOT);
+        std::fill(machine2TaskSlots.begin(), machine2TaskSlots.end(), NO_SLOT);
+    }
+
+    void pushBlock(const MachineBlock &block)
+    {
+        auto machine = getMachine(block.machineNumber);
+        utils::StartCause startCause = utils::TIME_ZERO;
+        if(!machine->empty())
+        {
+            if(block.start != machine->back().end) startCause = utils::CORRESPONDING_OPERATION;
+            else startCause = machine->back().blockType == utils::MAINTENANCE ? utils::PREVIOUS_MAINTENANCE : utils::PREVIOUS_OPERATION;
+        }
+        machine->push_back(block);
+        machine->back().startCause = startCause;
+        MachineTail* tail = getMachineTail(block.machineNumber);
+        if(block.blockType == utils::OPERATION)
+        {
+            auto slots = getMachineTaskSlots(block.machineNumber);
+            if(block.taskNumber >= slots->size()) slots->resize(block.taskNumber + 1, NO_SLOT);
+            (*slots)[block.taskNumber] = machine->size() - 1;
+            tail->lastOperationEnd = block.end;
+            cMax = std::max(cMax, block.end);
+        }
+        else tail->lastMaintenanceEnd = block.end;
+    }
+
+    std::string toString() const
     {
         std::string output;
         for (auto &&block : machine1)
@@ -108,29 +462,75 @@ struct Solution
         return output;
     }
 
-    Solution& randomSolution(std::list<MachineBlock> blocks)
+    Solution& randomSolution(const BlockOrder &order)
     {
+        std::deque<BlockIndex> blocks(order.begin(), order.end());
+        std::size_t rejectedInARow = 0;
         while (!blocks.empty())
         {
-            MachineBlock candidate = blocks.front();
+            BlockIndex index = blocks.front();
+            MachineBlock candidate = settings->blocks[index];
             blocks.pop_front();
-            isBlockValidToPutOnMachine(candidate) ? addBlockToMachine(candidate) : blocks.push_back(candidate);
+            // a whole pass without placing anything would loop forever, place the block after its corresponding operation instead
+            if(rejectedInARow > blocks.size())
+            {
+                addOrderedBlockToMachine(candidate);
+                rejectedInARow = 0;
+            }
+            else if(isBlockValidToPutOnMachine(candidate))
+            {
+                addBlockToMachine(candidate);
+                rejectedInARow = 0;
+            }
+            else
+            {
+                blocks.push_back(index);
+                ++rejectedInARow;
+            }
         }
 
         return *this;        
     }
 
-    Solution& orderedSolution(std::list<MachineBlock> blocks)
+    Solution& orderedSolution(const BlockOrder &order)
+    {
+        return orderedSolution(order.begin(), order.end());
+    }
+
+    // Decodes [first, last) on top of the current state, optionally recording a checkpoint before every block
+    Solution& orderedSolution(BlockOrder::const_iterator first, BlockOrder::const_iterator last, std::vector<DecodeCheckpoint>* checkpoints = nullptr)
     {
-        while(!blocks.empty())
+        for (; first != last; ++first)
         {
-            MachineBlock candidate = blocks.front();
-            blocks.pop_front();
+            if(checkpoints) checkpoints->push_back(getCheckpoint());
+            MachineBlock candidate = settings->blocks[*first];
             addOrderedBlockToMachine(candidate);
         }
         return *this;
     }
 
+    DecodeCheckpoint getCheckpoint()
+    {
+        return {static_cast<unsigned int>(machine1.size()), static_cast<unsigned int>(machine2.size()), machine1Tail, machine2Tail, cMax};
+    }
+
+    // Makes this solution equal to `decoded` as it was when `checkpoint` was taken
+    Solution& restoreCheckpoint(const Solution &decoded, const DecodeCheckpoint &checkpoint)
+    {
+        machine1.assign(decoded.machine1.begin(), decoded.machine1.begin() + checkpoint.machine1Size);
+        machine2.assign(decoded.machine2.begin(), decoded.machine2.begin() + checkpoint.machine2Size);
+        machine1TaskSlots = decoded.machine1TaskSlots;
+        machine2TaskSlots = decoded.machine2TaskSlots;
+        for (auto it = decoded.machine1.begin() + checkpoint.machine1Size; it != decoded.machine1.end(); ++it)
+            if(it->blockType == utils::OPERATION) machine1TaskSlots[it->taskNumber] = NO_SLOT;
+        for (auto it = decoded.machine2.begin() + checkpoint.machine2Size; it != decoded.machine2.end(); ++it)
+            if(it->blockType == utils::OPERATION) machine2TaskSlots[it->taskNumber] = NO_SLOT;
+        machine1Tail = checkpoint.machine1Tail;
+        machine2Tail = checkpoint.machine2Tail;
+        cMax = checkpoint.cMax;
+        return *this;
+    }
+
     bool isBlockValidToPutOnMachine(const MachineBlock &candidate)
     {
         assert(candidate.blockType == utils::OPERATION);
@@ -150,10 +550,10 @@ struct Solution
 
         utils::MachineNumber machineNumberToSearch = (operation.machineNumber == utils::MACHINE1) ? utils::MACHINE2 : utils::MACHINE1;
         auto machineToSearch = getMachine(machineNumberToSearch);
+        auto slots = getMachineTaskSlots(machineNumberToSearch);
 
-        auto itCorrespondingOperation = std::find_if(machineToSearch->begin(), machineToSearch->end(),[&](MachineBlock &x){ return x.taskNumber == operation.taskNumber; });
-        if(itCorrespondingOperation != machineToSearch->end())
-            return std::optional<MachineBlock*>(&(*itCorrespondingOperation));
+        if(operation.taskNumber < slots->size() && (*slots)[operation.taskNumber] != NO_SLOT)
+            return std::optional<MachineBlock*>(&(*machineToSearch)[(*slots)[operation.taskNumber]]);
         else return std::nullopt;
     }
 
@@ -178,13 +578,13 @@ struct Solution
             {
                 candidate.start = 0;
                 candidate.end = candidate.length;
-                machine->push_back(candidate);
+                pushBlock(candidate);
             }
             else
             {
                 candidate.start = machine->back().end;
                 candidate.end = candidate.start + candidate.length;
-                machine->push_back(candidate);
+                pushBlock(candidate);
             }
         }
         else
@@ -192,11 +592,11 @@ struct Solution
              MachineBlock maintenance;
              maintenance.blockType = utils::MAINTENANCE;
              maintenance.start = machine->back().end;
-             maintenance.length = utils::settings->maintenanceLength;
+             maintenance.length = settings->maintenanceLength;
              maintenance.end = maintenance.start + maintenance.length;
              maintenance.machineNumber = candidate.machineNumber;
 
-             machine->push_back(maintenance);
+             pushBlock(maintenance);
              return addBlockToMachine(candidate);
         }
     }
@@ -215,13 +615,13 @@ struct Solution
                 {
                     candidate.start = 0;
                     candidate.end = candidate.length;
-                    machine->push_back(candidate);
+                    pushBlock(candidate);
                 }
                 else
                 {
                     candidate.start = machine->back().end;
                     candidate.end = candidate.start + candidate.length;
-                    machine->push_back(candidate);
+                    pushBlock(candidate);
                 }
             }
             else
@@ -232,18 +632,18 @@ struct Solution
                 {
                     candidate.start = correspondingOperation->end;
                     candidate.end = candidate.length + candidate.start;
-                    machine->push_back(candidate);
+                    pushBlock(candidate);
                 }
                 else
                 {
                     MachineBlock maintenance;
                     maintenance.blockType = utils::MAINTENANCE;
                     maintenance.start = machine->back().end;
-                    maintenance.length = utils::settings->maintenanceLength;
+                    maintenance.length = settings->maintenanceLength;
                     maintenance.end = maintenance.start + maintenance.length;
                     maintenance.machineNumber = candidate.machineNumber;
 
-                    machine->push_back(maintenance);
+                    pushBlock(maintenance);
                     return addOrderedBlockToMachine(candidate);
                 }
                 
@@ -254,11 +654,11 @@ struct Solution
              MachineBlock maintenance;
              maintenance.blockType = utils::MAINTENANCE;
              maintenance.start = machine->back().end;
-             maintenance.length = utils::settings->maintenanceLength;
+             maintenance.length = settings->maintenanceLength;
              maintenance.end = maintenance.start + maintenance.length;
              maintenance.machineNumber = candidate.machineNumber;
 
-             machine->push_back(maintenance);
+             pushBlock(maintenance);
              return addOrderedBlockToMachine(candidate);
         }
     }
@@ -270,249 +670,2061 @@ struct Solution
 
     unsigned int getTimeToNextMaintenance(utils::MachineNumber &machineNumber)
     {
-        auto lastMaintenance = getLastMachineBlock(machineNumber, utils::MAINTENANCE);
-        auto lastOperation = getLastMachineBlock(machineNumber, utils::OPERATION);
-        unsigned int lastMaintenanceEndTime = lastMaintenance.has_value() ? lastMaintenance.value().end : 0;
-        unsigned int lastOperationEndTime = lastOperation.has_value() ? lastOperation.value().end : 0;
+        MachineTail* tail = getMachineTail(machineNumber);
+        unsigned int lastMaintenanceEndTime = tail->lastMaintenanceEnd;
+        unsigned int lastOperationEndTime = tail->lastOperationEnd;
 
-        return utils::settings->maintenancePeriod - abs(lastOperationEndTime - lastMaintenanceEndTime);
+        return settings->maintenancePeriod - abs(lastOperationEndTime - lastMaintenanceEndTime);
     }
 
-    unsigned int getCmax()
+    unsigned int getCmax() const
     {
-        auto compareEndTime = [](const MachineBlock& x, const MachineBlock& y){ return x.end < y.end; };
-        auto lastM1operation = getLastMachineBlock(utils::MACHINE1, utils::OPERATION);
-        auto lastM1operationValue = lastM1operation.value();
-        auto lastM2operation = getLastMachineBlock(utils::MACHINE2, utils::OPERATION);
-        auto lastM2operationValue = lastM2operation.value();
-        auto lastOperation = std::max(lastM1operationValue, lastM2operationValue, compareEndTime);
-        return lastOperation.end;
+        return cMax;
     }
 
-    std::optional<MachineBlock> getLastMachineBlock(const utils::MachineNumber &machine, const utils::BlockType &block)
+    // Operations on the chain of start causes that ends with the operation finishing at Cmax, latest first
+    std::vector<MachineBlock> getCriticalOperations() const
     {
-        auto machineToSearch = machine == utils::MACHINE1 ? machine1 : machine2;
-        auto it = std::find_if(machineToSearch.rbegin(), machineToSearch.rend(), [&](MachineBlock &x){ return x.blockType == block;});
-        if (it != machineToSearch.rend())
-            return std::optional<MachineBlock>(*it);
-        else
-            return std::nullopt;
+        std::vector<MachineBlock> criticalOperations;
+        bool isMachine1Last = !machine1.empty() && machine1Tail.lastOperationEnd == cMax;
+        const std::vector<MachineBlock>* machine = isMachine1Last ? &machine1 : &machine2;
+        if(machine->empty()) return criticalOperations;
+
+        std::size_t index = machine->size() - 1;
+        while (true)
+        {
+            const MachineBlock &block = (*machine)[index];
+            if(block.blockType == utils::OPERATION) criticalOperations.push_back(block);
+            if(block.startCause == utils::TIME_ZERO) break;
+            if(block.startCause == utils::CORRESPONDING_OPERATION)
+            {
+                bool isOnMachine1 = machine == &machine1;
+                machine = isOnMachine1 ? &machine2 : &machine1;
+                index = (isOnMachine1 ? machine2TaskSlots : machine1TaskSlots)[block.taskNumber];
+            }
+            else --index;
+        }
+        return criticalOperations;
     }
 };
 
-struct SwapListEntry
+// Replays the placement rules of Solution::addOrderedBlockToMachine on plain integers to score swapped orders
+// without building them. Operations of the unswapped prefix are read from the decoded order, operations placed
+// during an evaluation are stamped so the per-task arrays never have to be cleared.
+class MakespanEvaluator
 {
+private:
+    struct MachineState
+    {
+        unsigned int end = 0;
+        unsigned int lastOperationEnd = 0;
+        unsigned int lastMaintenanceEnd = 0;
+    };
+
+    struct PlacedOperation
+    {
+        unsigned int start = 0;
+        unsigned int length = 0;
+        unsigned int stamp = 0;
+    };
+
+    const ProblemInstance* settings;
+    const Solution* decoded = nullptr;
+    const std::vector<DecodeCheckpoint>* checkpoints = nullptr;
+    std::vector<PlacedOperation> machine1Operations;
+    std::vector<PlacedOperation> machine2Operations;
+    unsigned int stamp = 0;
+    DecodeCheckpoint checkpoint;
+    MachineState machine1State;
+    MachineState machine2State;
     unsigned int cMax = 0;
-    Solution solution;
-    std::pair<MachineBlock, MachineBlock> swap;
-};
 
-bool operator== (std::pair<MachineBlock, MachineBlock>& x, std::pair<MachineBlock, MachineBlock>& y)
-{
-    auto b1 = x.first == y.first || x.first == y.second;
-    auto b2 = x.second == y.first || x.second == y.second;
-    return b1 && b2;
-}
+    std::vector<PlacedOperation>* getOperations(utils::MachineNumber machineNumber)
+    {
+        return machineNumber == utils::MACHINE1 ? &machine1Operations : &machine2Operations;
+    }
 
-class TabuSearch
-{
-private:
-    std::random_device rd;
-    std::mt19937 randomGenerator;
-    ProblemInstance* settings;
-    
-public:
-    Solution bestSolution;
-    Solution currentSolution;
-    TabuSearch(ProblemInstance &settings):settings(&settings), randomGenerator(rd()){}
+    MachineState* getState(utils::MachineNumber machineNumber)
+    {
+        return machineNumber == utils::MACHINE1 ? &machine1State : &machine2State;
+    }
 
-    std::list<MachineBlock> createRandomOrder()
-    {   
-        unsigned int numberOfMachines = 2;
-        std::vector<MachineBlock> tmpVector;
-        // tmpVector.reserve(settings->tasks.size() * numberOfMachines);
-        for (auto &&task : settings->tasks)
+    void resume(const DecodeCheckpoint &checkpoint)
+    {
+        this->checkpoint = checkpoint;
+        machine1State = {checkpoint.machine1Size == 0 ? 0 : decoded->machine1[checkpoint.machine1Size - 1].end, checkpoint.machine1Tail.lastOperationEnd, checkpoint.machine1Tail.lastMaintenanceEnd};
+        machine2State = {checkpoint.machine2Size == 0 ? 0 : decoded->machine2[checkpoint.machine2Size - 1].end, checkpoint.machine2Tail.lastOperationEnd, checkpoint.machine2Tail.lastMaintenanceEnd};
+        cMax = checkpoint.cMax;
+        if(++stamp == 0)
         {
-            MachineBlock block1, block2;
-            block1.blockType = utils::OPERATION;
-            block1.machineNumber = utils::MACHINE1;
-            block1.length = task.machineLengthMap[utils::MACHINE1];
-            block1.taskNumber = task.taskNumber;
-
-            block2.blockType = utils::OPERATION;
-            block2.machineNumber = utils::MACHINE2;
-            block2.length = task.machineLengthMap[utils::MACHINE2];
-            block2.taskNumber = task.taskNumber;
-            
-            tmpVector.push_back(block1);
-            tmpVector.push_back(block2);
+            for (auto &&operation : machine1Operations) operation.stamp = 0;
+            for (auto &&operation : machine2Operations) operation.stamp = 0;
+            stamp = 1;
         }
-        std::shuffle(tmpVector.begin(), tmpVector.end(), randomGenerator);
-        std::list<MachineBlock> machineBlockList(tmpVector.begin(), tmpVector.end());
-        return machineBlockList;
     }
 
-    std::list<MachineBlock> getBlocksOrder(Solution &solution)
+    const PlacedOperation* findCorrespondingOperation(const MachineBlock &operation)
     {
-        std::vector<MachineBlock> tmpVector;
-        tmpVector.insert(tmpVector.end(), solution.machine1.begin(), solution.machine1.end());
-        tmpVector.insert(tmpVector.end(), solution.machine2.begin(), solution.machine2.end());
-        std::list<MachineBlock> blocks(tmpVector.begin(), tmpVector.end());
+        utils::MachineNumber machineNumberToSearch = (operation.machineNumber == utils::MACHINE1) ? utils::MACHINE2 : utils::MACHINE1;
+        PlacedOperation &placed = (*getOperations(machineNumberToSearch))[operation.taskNumber];
+        if(placed.stamp == stamp) return &placed;
 
-        blocks.remove_if([](MachineBlock x){return x.blockType == utils::MAINTENANCE;});
-        std::for_each(blocks.begin(), blocks.end(), [](MachineBlock &x){ x.start = 0; x.end = 0;});
-        return blocks;
+        auto &slots = machineNumberToSearch == utils::MACHINE1 ? decoded->machine1TaskSlots : decoded->machine2TaskSlots;
+        auto &machine = machineNumberToSearch == utils::MACHINE1 ? decoded->machine1 : decoded->machine2;
+        unsigned int prefixSize = machineNumberToSearch == utils::MACHINE1 ? checkpoint.machine1Size : checkpoint.machine2Size;
+        if(operation.taskNumber < slots.size() && slots[operation.taskNumber] != Solution::NO_SLOT && slots[operation.taskNumber] < (int)prefixSize)
+        {
+            const MachineBlock &block = machine[slots[operation.taskNumber]];
+            placed = {block.start, block.length, stamp};
+            return &placed;
+        }
+        return nullptr;
     }
 
-    TabuSearch& createInitialSolution()
+    static bool areBlocksColliding(unsigned int start, unsigned int length, const PlacedOperation &correspondingOperation)
     {
-        currentSolution.machine1.clear();
-        currentSolution.machine2.clear();
-        std::list<MachineBlock> blocks = this->createRandomOrder();
-        currentSolution.randomSolution(blocks);
-        return *this;
+        if(start < correspondingOperation.start) return correspondingOperation.start - start < length;
+        if(correspondingOperation.start < start) return start - correspondingOperation.start < correspondingOperation.length;
+        return 0 < length;
     }
 
-    std::vector<std::pair<MachineBlock, MachineBlock>> generateCandidatesForSwap(std::list<MachineBlock> &blocks)
+    unsigned int getTimeToNextMaintenance(const MachineState &state)
     {
-        unsigned int candidatesCount = utils::settings->neighbourSearchCount;
-        std::vector<std::pair<MachineBlock, MachineBlock>> swapCandidates;
-        swapCandidates.reserve(candidatesCount);
+        return settings->maintenancePeriod - abs(state.lastOperationEnd - state.lastMaintenanceEnd);
+    }
 
-        do
+    void addOrderedBlockToMachine(const MachineBlock &candidate)
+    {
+        MachineState &state = *getState(candidate.machineNumber);
+        while (getTimeToNextMaintenance(state) < candidate.length)
         {
-            std::pair<MachineBlock, MachineBlock> swap = getRandomSwap(blocks);
-            if(isSwapCandidateInSwapList(swap, swapCandidates)) continue;
-            else swapCandidates.push_back(swap);
+            state.end += settings->maintenanceLength;
+            state.lastMaintenanceEnd = state.end;
         }
-        while (swapCandidates.size() != candidatesCount);
 
-        return swapCandidates;
-    }
+        unsigned int start = state.end;
+        const PlacedOperation* correspondingOperation = findCorrespondingOperation(candidate);
+        if(correspondingOperation && areBlocksColliding(start, candidate.length, *correspondingOperation))
+            start = correspondingOperation->start + correspondingOperation->length;
 
-    std::pair<MachineBlock, MachineBlock> getRandomSwap(const std::list<MachineBlock> &blocks)
-    {
-        std::vector<MachineBlock> tempVector(blocks.begin(), blocks.end());
-        std::shuffle(tempVector.begin(), tempVector.end(), randomGenerator);
-        MachineBlock first = tempVector.back();
-        tempVector.pop_back();
-        auto it = std::find_if(tempVector.begin(), tempVector.end(), [&](MachineBlock &x){ return x.machineNumber == first.machineNumber;});
-        assert(it != tempVector.end());
-        MachineBlock second = *it;
-        return std::make_pair(first, second);
+        state.end = start + candidate.length;
+        state.lastOperationEnd = state.end;
+        cMax = std::max(cMax, state.end);
+        (*getOperations(candidate.machineNumber))[candidate.taskNumber] = {start, candidate.length, stamp};
     }
 
-    bool isSwapCandidateInSwapList(std::pair<MachineBlock, MachineBlock> swap,const std::vector<std::pair<MachineBlock, MachineBlock>> &swapList)
+public:
+    MakespanEvaluator(const ProblemInstance &settings):settings(&settings){}
+
+    void setDecodedOrder(const Solution &decoded, const std::vector<DecodeCheckpoint> &checkpoints)
     {
-        return std::any_of(swapList.begin(), swapList.end(), [&](std::pair<MachineBlock, MachineBlock> x){ return x == swap;});
+        this->decoded = &decoded;
+        this->checkpoints = &checkpoints;
+        std::size_t taskSlots = std::max(decoded.machine1TaskSlots.size(), decoded.machine2TaskSlots.size());
+        if(machine1Operations.size() < taskSlots)
+        {
+            machine1Operations.resize(taskSlots);
+            machine2Operations.resize(taskSlots);
+        }
     }
 
-    std::list<MachineBlock> swap(std::pair<MachineBlock, MachineBlock> &pair, std::list<MachineBlock> list)
+    // Cmax of the order whose blocks from `firstPosition` on are given by blockAt(position) and whose prefix is the
+    // decoded order. Evaluation stops as soon as the partial Cmax exceeds `bound`, the returned value is then only
+    // known to be greater than `bound`.
+    template <typename BlockAt>
+    unsigned int evaluate(unsigned int firstPosition, unsigned int size, BlockAt blockAt, unsigned int bound)
     {
-        auto it1 = std::find(list.begin(), list.end(), pair.first);
-        auto it2 = std::find(list.begin(), list.end(), pair.second);
-        assert(it1 != list.end() && it2 != list.end());
-        std::swap(*it1, *it2);
-        return list;
+        resume((*checkpoints)[firstPosition]);
+        for (unsigned int position = firstPosition; position < size && cMax <= bound; ++position)
+            addOrderedBlockToMachine(settings->blocks[blockAt(position)]);
+        return cMax;
     }
 
-    float calculateSD(std::vector<int> &localCmaxs)
+    // Cmax of `order` (the decoded order) with the two blocks of `swap` exchanged
+    unsigned int evaluateSwap(const BlockOrder &order, const std::vector<unsigned int> &positions, const BlockSwap &swap,
+        unsigned int bound = std::numeric_limits<unsigned int>::max())
     {
-        if(localCmaxs.size() < 300) return 999;
-        float sum = 0.0, mean, standardDeviation = 0.0;
-        sum = std::accumulate(localCmaxs.begin(), localCmaxs.end(), 0);
-        mean = sum/localCmaxs.size();
-        for (auto &&cmax : localCmaxs)
+        unsigned int firstPosition = std::min(positions[swap.first], positions[swap.second]);
+        return evaluate(firstPosition, order.size(), [&](unsigned int position)
         {
-            standardDeviation += pow(cmax - mean, 2);
-        }
-        
-        return sqrt(standardDeviation / localCmaxs.size());
+            BlockIndex index = order[position];
+            if(index == swap.first) return swap.second;
+            if(index == swap.second) return swap.first;
+            return index;
+        }, bound);
     }
 
-    void optimizeLocaly()
+    // Cmax of `order` (the decoded order) with `block` removed and reinserted at `target`
+    unsigned int evaluateInsertion(const BlockOrder &order, const std::vector<unsigned int> &positions, BlockIndex block, unsigned int target,
+        unsigned int bound = std::numeric_limits<unsigned int>::max())
     {
-        std::list<std::pair<MachineBlock, MachineBlock>> tabuList;
-        std::vector<int> localCmaxs;
-        do
+        unsigned int position = positions[block];
+        return evaluate(std::min(position, target), order.size(), [&](unsigned int current)
         {
-            std::list<MachineBlock> blocks = getBlocksOrder(currentSolution);
-            auto swapList = generateCandidatesForSwap(blocks);
-            std::vector<SwapListEntry> localSearch;
-            std::vector<SwapListEntry> filteredLocalSearch;
-            for (auto &&pair : swapList)
-            {
-                auto swappedOrder = swap(pair, blocks);
-                Solution solution;
-                solution.orderedSolution(swappedOrder);
-                SwapListEntry entry;
-                entry.cMax = solution.getCmax();
-                entry.solution = solution;
-                entry.swap = pair;
-                localSearch.push_back(entry);
-            }
-            //add solution if swap not in tabu OR cMax is greater than in best solution
-            for (auto &&swapEntry : localSearch)
-            {
-                if(isSwapCandidateInSwapList(swapEntry.swap, std::vector<std::pair<MachineBlock, MachineBlock>>(tabuList.begin(), tabuList.end())))
-                {
-                    if(swapEntry.cMax < bestSolution.getCmax())
-                    {
-                        filteredLocalSearch.push_back(swapEntry);
-                    }
-                }
-                else
-                {
-                    filteredLocalSearch.push_back(swapEntry);
-                }
-            }
-
-            std::sort(filteredLocalSearch.begin(), filteredLocalSearch.end(), [](SwapListEntry &x, SwapListEntry &y){return x.cMax < y.cMax;});
-            SwapListEntry bestEntry = filteredLocalSearch.front();
-            localCmaxs.push_back(bestEntry.cMax);
-            tabuList.push_back(bestEntry.swap);
-            currentSolution = bestEntry.solution;
-            if(currentSolution.getCmax() < bestSolution.getCmax()) bestSolution = currentSolution;
-            if(tabuList.size() > utils::settings->tabuListSize) tabuList.pop_front();
-            
-        } while (calculateSD(localCmaxs) > 1);
+            if(current == target) return block;
+            if(position < target && position <= current && current < target) return order[current + 1];
+            if(target < position && target < current && current <= position) return order[current - 1];
+            return order[current];
+        }, bound);
     }
 
+    unsigned int evaluateMove(const BlockOrder &order, const std::vector<unsigned int> &positions, const Move &move,
+        unsigned int bound = std::numeric_limits<unsigned int>::max())
+    {
+        if(move.type == utils::SWAP) return evaluateSwap(order, positions, std::make_pair(move.block, move.target), bound);
+        return evaluateInsertion(order, positions, move.block, move.target, bound);
+    }
 };
 
-ProblemInstance loadProblemInstance(const char* filepath)
+// Persistent threads that share the indices of a parallelFor call; the calling thread works as worker 0
+class WorkerPool
 {
-    std::ifstream file(filepath);
-    Json jsonParser;
-    file >> jsonParser;
-    std::vector<Task> tasks;
-    tasks.reserve(jsonParser.size());
-    for (auto && task: jsonParser["tasks"].items())
-        tasks.push_back(Task(std::strtoul(task.key().c_str(), NULL, 10), task.value()["1"], task.value()["2"]));
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+    std::function<void(unsigned int, std::size_t)> task;
+    std::size_t taskSize = 0;
+    std::atomic<std::size_t> nextIndex{0};
+    unsigned int generation = 0;
+    unsigned int pendingWorkers = 0;
+    bool stopping = false;
 
-    return ProblemInstance(jsonParser["maintenanceLength"], jsonParser["maintenancePeriod"], jsonParser["neighbourSearchCount"],
-        jsonParser["algorithmRetries"], jsonParser["operationRenewPunishmentFactor"], tasks);
-}
+    void runTask(unsigned int worker)
+    {
+        for (std::size_t index = nextIndex++; index < taskSize; index = nextIndex++)
+            task(worker, index);
+    }
 
+    void workerLoop(unsigned int worker)
+    {
+        unsigned int seenGeneration = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            startCondition.wait(lock, [&]{ return stopping || generation != seenGeneration; });
+            if(stopping) return;
+            seenGeneration = generation;
+            lock.unlock();
+            runTask(worker);
+            lock.lock();
+            if(--pendingWorkers == 0) doneCondition.notify_one();
+        }
+    }
 
-int main(int argc, char const *argv[])
-{
-    const char* filepath = argv[1];
+public:
+    WorkerPool(unsigned int workerCount)
+    {
+        for (unsigned int worker = 1; worker < workerCount; ++worker)
+            threads.emplace_back(&WorkerPool::workerLoop, this, worker);
+    }
 
-    ProblemInstance settings = loadProblemInstance(filepath);
-    utils::settings = &settings;
-    TabuSearch algorithm(settings);
-    algorithm.createInitialSolution();
-    algorithm.bestSolution = algorithm.currentSolution;
-    int retries = 0;
-    do
+    ~WorkerPool()
     {
-        algorithm.createInitialSolution();
-        algorithm.optimizeLocaly();
-        printf("[Retry %d] Best Solution: %d\n", retries, algorithm.bestSolution.getCmax());
-        
-    } while (++retries < utils::settings->algorithmRetries);
-    std::cout << algorithm.bestSolution.toString() << std::endl;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        startCondition.notify_all();
+        for (auto &&thread : threads) thread.join();
+    }
+
+    unsigned int size() const
+    {
+        return threads.size() + 1;
+    }
+
+    // Calls function(worker, index) once for every index in [0, count) and returns when all calls are done
+    void parallelFor(std::size_t count, const std::function<void(unsigned int, std::size_t)> &function)
+    {
+        if(threads.empty() || count < 2)
+        {
+            for (std::size_t index = 0; index < count; ++index) function(0, index);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = function;
+            taskSize = count;
+            nextIndex = 0;
+            pendingWorkers = threads.size();
+            ++generation;
+        }
+        startCondition.notify_all();
+        runTask(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [&]{ return pendingWorkers == 0; });
+    }
+};
+
+// Best solution found by any of the concurrent searches. Improvements are published with compare-and-swap on the
+// head of a chain of published solutions, readers never block: getCmax is a single atomic load. Replaced solutions
+// stay in the chain until the incumbent is destroyed, so a reader can keep the one it got.
+class SharedIncumbent
+{
+private:
+    struct Published
+    {
+        Solution solution;
+        const Published* previous = nullptr;
+
+        Published(const Solution &solution):solution(solution) {}
+    };
+
+    std::atomic<unsigned int> cMax{std::numeric_limits<unsigned int>::max()};
+    std::atomic<const Published*> best{nullptr};
+
+public:
+    SharedIncumbent() = default;
+    SharedIncumbent(const SharedIncumbent&) = delete;
+    SharedIncumbent& operator = (const SharedIncumbent&) = delete;
+
+    ~SharedIncumbent()
+    {
+        for (const Published* published = best.load(); published != nullptr;)
+        {
+            const Published* previous = published->previous;
+            delete published;
+            published = previous;
+        }
+    }
+
+    unsigned int getCmax() const
+    {
+        return cMax.load(std::memory_order_acquire);
+    }
+
+    // null until the first offer, valid for the lifetime of the incumbent
+    const Solution* getSolution() const
+    {
+        const Published* published = best.load(std::memory_order_acquire);
+        return published ? &published->solution : nullptr;
+    }
+
+    // Publishes `candidate` if it beats the incumbent, returns whether it did
+    bool offer(const Solution &candidate)
+    {
+        unsigned int candidateCmax = candidate.getCmax();
+        if(candidateCmax >= getCmax()) return false;
+
+        Published* published = new Published(candidate);
+        const Published* current = best.load(std::memory_order_acquire);
+        do
+        {
+            if(current && current->solution.getCmax() <= candidateCmax)
+            {
+                delete published;
+                return false;
+            }
+            published->previous = current;
+        } while (!best.compare_exchange_weak(current, published, std::memory_order_acq_rel, std::memory_order_acquire));
+
+        unsigned int currentCmax = cMax.load(std::memory_order_relaxed);
+        while (candidateCmax < currentCmax && !cMax.compare_exchange_weak(currentCmax, candidateCmax, std::memory_order_release));
+        return true;
+    }
+};
+
+struct MoveListEntry
+{
+    unsigned int cMax = 0;
+    Move move;
+};
+
+// The `size` smallest Cmax values offered by the scan threads. Once it holds `size` of them its bound is the largest,
+// a move evaluated above the bound cannot enter the ranking. Offers only lock when they beat the bound.
+class CmaxRanking
+{
+private:
+    std::size_t size;
+    // max-heap
+    std::vector<unsigned int> ranked;
+    std::mutex mutex;
+    std::atomic<unsigned int> bound{std::numeric_limits<unsigned int>::max()};
+
+public:
+    CmaxRanking(std::size_t size):size(std::max<std::size_t>(1, size))
+    {
+        ranked.reserve(this->size + 1);
+    }
+
+    unsigned int getBound() const
+    {
+        return bound.load(std::memory_order_relaxed);
+    }
+
+    void offer(unsigned int cMax)
+    {
+        if(cMax >= getBound()) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if(ranked.size() == size && cMax >= ranked.front()) return;
+        ranked.push_back(cMax);
+        std::push_heap(ranked.begin(), ranked.end());
+        if(ranked.size() > size)
+        {
+            std::pop_heap(ranked.begin(), ranked.end());
+            ranked.pop_back();
+        }
+        if(ranked.size() == size) bound.store(ranked.front(), std::memory_order_relaxed);
+    }
+};
+
+// Moves made during the last `tenure` iterations. Moves are integer keys kept in an open-addressing hash set
+// (linear probing), a ring buffer of the same keys expires the oldest move when a new one is pushed.
+class TabuList
+{
+private:
+    struct Slot
+    {
+        std::uint64_t key = 0;
+        unsigned int count = 0;
+    };
+
+    std::vector<Slot> table;
+    std::size_t mask = 0;
+    std::vector<std::uint64_t> ring;
+    std::size_t ringStart = 0;
+    std::size_t ringSize = 0;
+
+    std::size_t getHomeSlot(std::uint64_t key) const
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return key & mask;
+    }
+
+    void insert(std::uint64_t key)
+    {
+        std::size_t slot = getHomeSlot(key);
+        while (table[slot].count != 0 && table[slot].key != key) slot = (slot + 1) & mask;
+        table[slot].key = key;
+        ++table[slot].count;
+    }
+
+    void erase(std::uint64_t key)
+    {
+        std::size_t slot = getHomeSlot(key);
+        while (table[slot].key != key || table[slot].count == 0) slot = (slot + 1) & mask;
+        if(--table[slot].count != 0) return;
+
+        // backward shift deletion keeps every probe sequence free of holes
+        std::size_t hole = slot;
+        for (std::size_t next = (hole + 1) & mask; table[next].count != 0; next = (next + 1) & mask)
+        {
+            std::size_t home = getHomeSlot(table[next].key);
+            if(((next - home) & mask) >= ((next - hole) & mask))
+            {
+                table[hole] = table[next];
+                table[next] = Slot();
+                hole = next;
+            }
+        }
+    }
+
+    // keeps the table at most half full
+    void reserve(unsigned int tenure)
+    {
+        std::size_t capacity = 8;
+        while (capacity < 2 * std::size_t(tenure)) capacity *= 2;
+        if(capacity <= table.size()) return;
+        table.assign(capacity, Slot());
+        mask = capacity - 1;
+        for (std::size_t entry = 0; entry < ringSize; ++entry) insert(ring[(ringStart + entry) % ring.size()]);
+    }
+
+public:
+    TabuList(unsigned int tenure):ring(tenure)
+    {
+        reserve(tenure);
+    }
+
+    unsigned int getTenure() const
+    {
+        return ring.size();
+    }
+
+    // Shrinking expires the oldest moves, growing keeps every move for the longer tenure
+    void setTenure(unsigned int tenure)
+    {
+        if(tenure == ring.size()) return;
+        for (; ringSize > tenure; --ringSize)
+        {
+            erase(ring[ringStart]);
+            ringStart = (ringStart + 1) % ring.size();
+        }
+        std::vector<std::uint64_t> resized(tenure);
+        for (std::size_t entry = 0; entry < ringSize; ++entry) resized[entry] = ring[(ringStart + entry) % ring.size()];
+        ring = std::move(resized);
+        ringStart = 0;
+        reserve(tenure);
+    }
+
+    // Same key for both orientations of a swap, blocks of one machine already encode (machine, task)
+    static std::uint64_t getMoveKey(const BlockSwap &swap)
+    {
+        return (std::uint64_t(std::min(swap.first, swap.second)) << 32) | std::max(swap.first, swap.second);
+    }
+
+    // `block` placed at `position`, the top bit keeps insertion keys apart from swap keys
+    static std::uint64_t getInsertionKey(BlockIndex block, unsigned int position)
+    {
+        return (std::uint64_t(1) << 63) | (std::uint64_t(block) << 32) | position;
+    }
+
+    bool contains(std::uint64_t key) const
+    {
+        for (std::size_t slot = getHomeSlot(key); table[slot].count != 0; slot = (slot + 1) & mask)
+            if(table[slot].key == key) return true;
+        return false;
+    }
+
+    void push(std::uint64_t key)
+    {
+        if(ring.empty()) return;
+        if(ringSize == ring.size())
+        {
+            erase(ring[ringStart]);
+            ringStart = (ringStart + 1) % ring.size();
+            --ringSize;
+        }
+        ring[(ringStart + ringSize) % ring.size()] = key;
+        ++ringSize;
+        insert(key);
+    }
+};
+
+struct EliteSolution
+{
+    BlockOrder order;
+    unsigned int cMax = 0;
+};
+
+// Best orders found across retries, kept apart from each other. An order closer than minimumDistance positions to one
+// member can only replace that member, an order close to several is rejected. Otherwise it joins the pool while there
+// is room or replaces the worst member it beats.
+class ElitePool
+{
+    std::vector<EliteSolution> members;
+    unsigned int capacity;
+    unsigned int minimumDistance;
+    mutable std::mutex mutex;
+
+public:
+    ElitePool(unsigned int capacity, unsigned int minimumDistance):capacity(capacity), minimumDistance(minimumDistance){}
+
+    // number of positions holding different blocks
+    static unsigned int getDistance(const BlockOrder &x, const BlockOrder &y)
+    {
+        unsigned int distance = 0;
+        for (std::size_t position = 0; position < x.size(); ++position) distance += x[position] != y[position];
+        return distance;
+    }
+
+    std::vector<EliteSolution> getMembers() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return members;
+    }
+
+    // returns whether the order joined the pool
+    bool offer(const BlockOrder &order, unsigned int cMax)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto close = members.end();
+        unsigned int closeCount = 0;
+        for (auto member = members.begin(); member != members.end(); ++member)
+        {
+            unsigned int distance = getDistance(order, member->order);
+            if(distance == 0) return false;
+            if(distance >= minimumDistance) continue;
+            close = member;
+            ++closeCount;
+        }
+        // replacing one of several close members would leave the order close to the others
+        if(closeCount > 1) return false;
+
+        auto replaced = close;
+        if(closeCount == 0)
+        {
+            if(members.size() < capacity)
+            {
+                members.push_back({order, cMax});
+                assert(isSpread());
+                return true;
+            }
+            replaced = std::max_element(members.begin(), members.end(), [](const EliteSolution &x, const EliteSolution &y){ return x.cMax < y.cMax; });
+        }
+
+        if(replaced == members.end() || cMax >= replaced->cMax) return false;
+        *replaced = {order, cMax};
+        assert(isSpread());
+        return true;
+    }
+
+private:
+    // every two members are at least minimumDistance apart
+    bool isSpread() const
+    {
+        for (std::size_t first = 0; first < members.size(); ++first)
+            for (std::size_t second = first + 1; second < members.size(); ++second)
+                if(getDistance(members[first].order, members[second].order) < minimumDistance) return false;
+        return true;
+    }
+};
+
+// Long-term memory of how often each operation stood at each position of its machine in the best order of a retry.
+// Orders drawn from it favour the positions seen most often (intensification) or the ones seen least often (diversification).
+class FrequencyMemory
+{
+    unsigned int tasksCount;
+    // counts[block * tasksCount + position on the machine of the block]
+    std::vector<unsigned int> counts;
+    unsigned int records = 0;
+    mutable std::mutex mutex;
+
+public:
+    FrequencyMemory(unsigned int tasksCount):tasksCount(tasksCount), counts(2 * std::size_t(tasksCount) * tasksCount){}
+
+    unsigned int getRecords() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return records;
+    }
+
+    void record(const BlockOrder &order)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (unsigned int position = 0; position < order.size(); ++position)
+            ++counts[std::size_t(order[position]) * tasksCount + position % tasksCount];
+        ++records;
+    }
+
+    // Fills the positions of each machine in turn, picking among the blocks left with weight 1 + count when intensifying
+    // and 1 + records - count when diversifying
+    template <typename RandomGenerator>
+    BlockOrder createOrder(const ProblemInstance &settings, bool intensify, RandomGenerator &randomGenerator) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        BlockOrder order;
+        order.reserve(2 * tasksCount);
+        std::vector<BlockIndex> left;
+        std::vector<std::uint64_t> weights;
+        for (auto &&machineNumber : {utils::MACHINE1, utils::MACHINE2})
+        {
+            left.clear();
+            for (unsigned int taskPosition = 0; taskPosition < tasksCount; ++taskPosition)
+                left.push_back(settings.getBlockIndex(taskPosition, machineNumber));
+            for (unsigned int position = 0; position < tasksCount; ++position)
+            {
+                weights.clear();
+                std::uint64_t totalWeight = 0;
+                for (auto &&block : left)
+                {
+                    unsigned int count = counts[std::size_t(block) * tasksCount + position];
+                    totalWeight += intensify ? 1 + count : 1 + records - count;
+                    weights.push_back(totalWeight);
+                }
+                std::uint64_t pick = std::uniform_int_distribution<std::uint64_t>(0, totalWeight - 1)(randomGenerator);
+                std::size_t chosen = std::upper_bound(weights.begin(), weights.end(), pick) - weights.begin();
+                order.push_back(left[chosen]);
+                left[chosen] = left.back();
+                left.pop_back();
+            }
+        }
+        return order;
+    }
+};
+
+// Reactive tenure (Battiti, Tecchiolli). Visited solutions are remembered by hash: coming back to one raises the tenure,
+// a stretch longer than the average cycle without repetitions lowers it, and solutions that keep repeating ask for an escape.
+class ReactiveTenure
+{
+    struct Visit
+    {
+        std::uint64_t iteration = 0;
+        unsigned int repetitions = 0;
+    };
+
+    std::unordered_map<std::uint64_t, Visit> visits;
+    double tenure;
+    unsigned int minTenure;
+    unsigned int maxTenure;
+    double averageCycleLength = 0;
+    std::uint64_t lastTenureChange = 0;
+    unsigned int oftenRepeated = 0;
+
+public:
+    static constexpr double increase = 1.1;
+    static constexpr double decrease = 0.9;
+    // a solution repeated more often than this counts as often repeated, that many often repeated solutions trigger an escape
+    static constexpr unsigned int repetitionLimit = 3;
+    static constexpr unsigned int oftenRepeatedLimit = 3;
+    // once this many solutions are remembered, the ones not visited in the last visitCapacity / 2 iterations are forgotten
+    static constexpr std::size_t visitCapacity = 1 << 16;
+
+    ReactiveTenure(unsigned int tenure, unsigned int maxTenure)
+    :tenure(std::max(1u, tenure)), minTenure(1), maxTenure(std::max(1u, maxTenure)){}
+
+    unsigned int getTenure() const
+    {
+        return static_cast<unsigned int>(tenure);
+    }
+
+    // random moves an escape should make
+    unsigned int getEscapeLength() const
+    {
+        return 1 + (1 + static_cast<unsigned int>(averageCycleLength)) / 2;
+    }
+
+    // records the solution of this iteration, returns true when the search should escape
+    bool visit(std::uint64_t solutionHash, std::uint64_t iteration)
+    {
+        // one solution is visited per iteration, so at most visitCapacity / 2 stay and trimming is amortized
+        if(visits.size() >= visitCapacity)
+        {
+            for (auto visit = visits.begin(); visit != visits.end();)
+            {
+                if(iteration - visit->second.iteration >= visitCapacity / 2) visit = visits.erase(visit);
+                else ++visit;
+            }
+        }
+        auto [visit, firstVisit] = visits.try_emplace(solutionHash, Visit{iteration, 0});
+        if(firstVisit)
+        {
+            if(iteration - lastTenureChange > averageCycleLength)
+            {
+                tenure = std::max<double>(minTenure, tenure * decrease);
+                lastTenureChange = iteration;
+            }
+            return false;
+        }
+
+        std::uint64_t cycleLength = iteration - visit->second.iteration;
+        visit->second.iteration = iteration;
+        if(++visit->second.repetitions > repetitionLimit && ++oftenRepeated > oftenRepeatedLimit)
+        {
+            oftenRepeated = 0;
+            visits.clear();
+            return true;
+        }
+        averageCycleLength = 0.1 * cycleLength + 0.9 * averageCycleLength;
+        tenure = std::min<double>(maxTenure, tenure * increase + 1);
+        lastTenureChange = iteration;
+        return false;
+    }
+};
+
+// Standard deviation of the last `length` values pushed. Running sums of the values in the window and of their
+// squares are updated when a value enters or leaves the ring buffer, so both operations are O(1).
+class ConvergenceWindow
+{
+    std::vector<unsigned int> values;
+    std::size_t next = 0;
+    std::size_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t sumOfSquares = 0;
+
+public:
+    ConvergenceWindow(unsigned int length) : values(std::max(1u, length)) {}
+
+    void push(unsigned int value)
+    {
+        if(count == values.size())
+        {
+            sum -= values[next];
+            sumOfSquares -= std::uint64_t(values[next]) * values[next];
+        }
+        else ++count;
+        values[next] = value;
+        sum += value;
+        sumOfSquares += std::uint64_t(value) * value;
+        next = next + 1 == values.size() ? 0 : next + 1;
+    }
+
+    bool isFull() const
+    {
+        return count == values.size();
+    }
+
+    double getStandardDeviation() const
+    {
+        if(count == 0) return 0;
+        // count * sumOfSquares - sum^2 is exact in integers, only the final division rounds
+        double spread = double(count * sumOfSquares - sum * sum);
+        return std::sqrt(std::max(0.0, spread)) / count;
+    }
+};
+
+// Wall-clock budget shared by every search thread. Loops whose steps are much cheaper than a clock read pass their
+// step count so the clock is read only every checkInterval steps, the first thread that sees the deadline pass
+// publishes it through a flag.
+class Deadline
+{
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    bool limited;
+    std::atomic<bool> passed{false};
+
+public:
+    static constexpr unsigned int checkInterval = 16;
+
+    Deadline(unsigned int timeLimitMs)
+    :start(std::chrono::steady_clock::now()), end(start + std::chrono::milliseconds(timeLimitMs)), limited(timeLimitMs > 0){}
+
+    bool isLimited() const
+    {
+        return limited;
+    }
+
+    bool hasPassed()
+    {
+        if(!limited) return false;
+        if(passed.load(std::memory_order_relaxed)) return true;
+        if(std::chrono::steady_clock::now() < end) return false;
+        passed.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    // share of the time limit used so far, between 0 and 1
+    double getProgress() const
+    {
+        if(!limited) return 0;
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return std::min(1.0, elapsed / std::chrono::duration<double>(end - start).count());
+    }
+
+    bool hasPassed(std::uint64_t step)
+    {
+        if(step % checkInterval == 0) return hasPassed();
+        return passed.load(std::memory_order_relaxed);
+    }
+};
+
+// Order and swap helpers shared by the solvers
+
+template <typename RandomGenerator>
+BlockOrder createRandomOrder(const ProblemInstance &settings, RandomGenerator &randomGenerator)
+{
+    // one block per operation length of either machine
+    BlockOrder order(settings.operationLengths[utils::MACHINE1].size() + settings.operationLengths[utils::MACHINE2].size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), randomGenerator);
+    return order;
+}
+
+// the operations of machine 1 in their order on it, then the ones of machine 2
+BlockOrder getBlocksOrder(const ProblemInstance &settings, const Solution &solution)
+{
+    BlockOrder order;
+    order.reserve(settings.blocks.size());
+    for (auto &&block : solution.machine1)
+        if(block.blockType == utils::OPERATION) order.push_back(settings.getBlockIndex(block));
+    for (auto &&block : solution.machine2)
+        if(block.blockType == utils::OPERATION) order.push_back(settings.getBlockIndex(block));
+    return order;
+}
+
+// blockIndex -> position of the block in order
+std::vector<unsigned int> getBlockPositions(const BlockOrder &order)
+{
+    std::vector<unsigned int> positions(order.size());
+    for (unsigned int position = 0; position < order.size(); ++position)
+        positions[order[position]] = position;
+    return positions;
+}
+
+// two blocks of the same machine: a random block, then a random other task on its machine
+template <typename RandomGenerator>
+BlockSwap getRandomSwap(const ProblemInstance &settings, RandomGenerator &randomGenerator)
+{
+    unsigned int tasksCount = settings.tasks.size();
+    BlockIndex first = std::uniform_int_distribution<BlockIndex>(0, 2 * tasksCount - 1)(randomGenerator);
+    utils::MachineNumber machineNumber = settings.blocks[first].machineNumber;
+    unsigned int firstTaskPosition = first / 2;
+    unsigned int secondTaskPosition = std::uniform_int_distribution<unsigned int>(0, tasksCount - 2)(randomGenerator);
+    if(secondTaskPosition >= firstTaskPosition) ++secondTaskPosition;
+    return std::make_pair(first, settings.getBlockIndex(secondTaskPosition, machineNumber));
+}
+
+void swap(const BlockSwap &swap, BlockOrder &order, std::vector<unsigned int> &positions)
+{
+    std::swap(order[positions[swap.first]], order[positions[swap.second]]);
+    std::swap(positions[swap.first], positions[swap.second]);
+}
+
+template <typename RandomGenerator = utils::Xoshiro256PlusPlus>
+class TabuSearch
+{
+private:
+    RandomGenerator randomGenerator;
+    const ProblemInstance* settings;
+    WorkerPool workers;
+    SharedIncumbent* incumbent;
+    Deadline* deadline;
+    
+    void resetRetryBest()
+    {
+        retryBestOrder = getBlocksOrder(*settings, currentSolution);
+        retryBestCmax = currentSolution.getCmax();
+    }
+
+    void updateRetryBest(const BlockOrder &order)
+    {
+        if(currentSolution.getCmax() >= retryBestCmax) return;
+        retryBestOrder = order;
+        retryBestCmax = currentSolution.getCmax();
+    }
+
+public:
+    Solution currentSolution;
+    std::uint64_t iterations = 0;
+    // best order of the current retry
+    BlockOrder retryBestOrder;
+    unsigned int retryBestCmax = 0;
+    TabuSearch(const ProblemInstance &settings, SharedIncumbent &incumbent, const RandomGenerator &randomGenerator, unsigned int threads = 1, Deadline* deadline = nullptr)
+    :randomGenerator(randomGenerator), settings(&settings), workers(threads), incumbent(&incumbent), deadline(deadline), currentSolution(settings){}
+
+    TabuSearch& createInitialSolution()
+    {
+        currentSolution.clear();
+        BlockOrder blocks = createRandomOrder(*settings, randomGenerator);
+        currentSolution.randomSolution(blocks);
+        resetRetryBest();
+        return *this;
+    }
+
+    // an order that came from elsewhere, decoded as it is
+    TabuSearch& createInitialSolution(const BlockOrder &order)
+    {
+        currentSolution.clear();
+        currentSolution.orderedSolution(order);
+        resetRetryBest();
+        return *this;
+    }
+
+    // an order drawn from the long-term memory, decoded as it is
+    TabuSearch& createInitialSolution(const FrequencyMemory &memory, bool intensify)
+    {
+        currentSolution.clear();
+        currentSolution.orderedSolution(memory.createOrder(*settings, intensify, randomGenerator));
+        resetRetryBest();
+        return *this;
+    }
+
+    std::uint64_t getSwapsPerMachine()
+    {
+        std::uint64_t tasksCount = settings->tasks.size();
+        return tasksCount * (tasksCount - 1) / 2;
+    }
+
+    // Swap number `swapIndex` in [0, 2 * getSwapsPerMachine()): machine, then pair (i < j) of task positions in triangular order
+    BlockSwap getSwap(std::uint64_t swapIndex)
+    {
+        std::uint64_t swapsPerMachine = getSwapsPerMachine();
+        utils::MachineNumber machineNumber = swapIndex < swapsPerMachine ? utils::MACHINE1 : utils::MACHINE2;
+        std::uint64_t pairIndex = swapIndex % swapsPerMachine;
+        std::uint64_t second = (1 + std::sqrt(1.0 + 8.0 * pairIndex)) / 2;
+        while (second * (second - 1) / 2 > pairIndex) --second;
+        while (second * (second + 1) / 2 <= pairIndex) ++second;
+        std::uint64_t first = pairIndex - second * (second - 1) / 2;
+        return std::make_pair(settings->getBlockIndex(first, machineNumber), settings->getBlockIndex(second, machineNumber));
+    }
+
+    // `count` distinct numbers from [0, universe) drawn with Floyd's algorithm, one random draw per number
+    std::vector<std::uint64_t> sampleDistinct(std::uint64_t count, std::uint64_t universe)
+    {
+        count = std::min(count, universe);
+        std::vector<std::uint64_t> samples;
+        samples.reserve(count);
+        std::unordered_set<std::uint64_t> sampled;
+        sampled.reserve(2 * count);
+
+        for (std::uint64_t upper = universe - count; upper < universe; ++upper)
+        {
+            std::uint64_t sample = std::uniform_int_distribution<std::uint64_t>(0, upper)(randomGenerator);
+            if(!sampled.insert(sample).second)
+            {
+                sample = upper;
+                sampled.insert(sample);
+            }
+            samples.push_back(sample);
+        }
+        return samples;
+    }
+
+    // neighbourSearchCount distinct swaps
+    std::vector<BlockSwap> generateCandidatesForSwap()
+    {
+        std::vector<BlockSwap> swapCandidates;
+        for (auto &&swapIndex : sampleDistinct(settings->neighbourSearchCount, 2 * getSwapsPerMachine()))
+            swapCandidates.push_back(getSwap(swapIndex));
+        return swapCandidates;
+    }
+
+    // every same-machine swap, in swap number order
+    std::vector<BlockSwap> generateAllSwaps()
+    {
+        unsigned int tasksCount = settings->tasks.size();
+        std::vector<BlockSwap> swaps;
+        swaps.reserve(2 * getSwapsPerMachine());
+        for (auto machineNumber : {utils::MACHINE1, utils::MACHINE2})
+            for (unsigned int second = 1; second < tasksCount; ++second)
+                for (unsigned int first = 0; first < second; ++first)
+                    swaps.push_back(std::make_pair(settings->getBlockIndex(first, machineNumber), settings->getBlockIndex(second, machineNumber)));
+        return swaps;
+    }
+
+    // getBlocksOrder lists the n operations of machine 1 before the n operations of machine 2, an insertion moves
+    // one of them to another position of its machine's part of the order
+    std::uint64_t getInsertionsPerMachine()
+    {
+        std::uint64_t tasksCount = settings->tasks.size();
+        return tasksCount * (tasksCount - 1);
+    }
+
+    // Insertion number `insertionIndex` in [0, 2 * getInsertionsPerMachine()): machine, moved position, target position
+    Move getInsertion(std::uint64_t insertionIndex, const BlockOrder &order)
+    {
+        unsigned int tasksCount = settings->tasks.size();
+        std::uint64_t insertionsPerMachine = getInsertionsPerMachine();
+        unsigned int machineStart = insertionIndex < insertionsPerMachine ? 0 : tasksCount;
+        std::uint64_t pairIndex = insertionIndex % insertionsPerMachine;
+        unsigned int from = pairIndex / (tasksCount - 1);
+        unsigned int to = pairIndex % (tasksCount - 1);
+        if(to >= from) ++to;
+        return Move::fromInsertion(order[machineStart + from], machineStart + to);
+    }
+
+    // Moves that take at least one operation of the critical chain of `decoded`, the decoding of the current order.
+    // Swaps pick a critical block and another task on its machine, insertions move a critical block within its
+    // machine's part.
+    std::vector<Move> generateCriticalCandidates(const Solution &decoded, const std::vector<unsigned int> &positions)
+    {
+        unsigned int tasksCount = settings->tasks.size();
+        std::vector<BlockIndex> criticalBlocks;
+        for (auto &&operation : decoded.getCriticalOperations()) criticalBlocks.push_back(settings->getBlockIndex(operation));
+        std::uint64_t movesCount = std::uint64_t(criticalBlocks.size()) * (tasksCount - 1);
+
+        std::vector<Move> candidates;
+        std::unordered_set<std::uint64_t> sampledSwaps;
+        for (auto &&swapIndex : sampleDistinct(settings->neighbourSearchCount, movesCount))
+        {
+            BlockIndex block = criticalBlocks[swapIndex / (tasksCount - 1)];
+            unsigned int taskPosition = settings->taskPositions[settings->blocks[block].taskNumber];
+            unsigned int otherTaskPosition = swapIndex % (tasksCount - 1);
+            if(otherTaskPosition >= taskPosition) ++otherTaskPosition;
+            BlockSwap swap = std::make_pair(block, settings->getBlockIndex(otherTaskPosition, settings->blocks[block].machineNumber));
+            // both blocks of a swap can be critical
+            if(sampledSwaps.insert(TabuList::getMoveKey(swap)).second) candidates.push_back(Move::fromSwap(swap));
+        }
+        for (auto &&insertionIndex : sampleDistinct(settings->insertionSearchCount, movesCount))
+        {
+            BlockIndex block = criticalBlocks[insertionIndex / (tasksCount - 1)];
+            unsigned int machineStart = settings->blocks[block].machineNumber == utils::MACHINE1 ? 0 : tasksCount;
+            unsigned int from = positions[block] - machineStart;
+            unsigned int to = insertionIndex % (tasksCount - 1);
+            if(to >= from) ++to;
+            candidates.push_back(Move::fromInsertion(block, machineStart + to));
+        }
+        return candidates;
+    }
+
+    std::vector<Move> generateAllCandidates(const BlockOrder &order)
+    {
+        std::vector<Move> candidates;
+        for (auto &&swap : generateAllSwaps()) candidates.push_back(Move::fromSwap(swap));
+        if(settings->insertionSearchCount > 0)
+            for (std::uint64_t insertionIndex = 0; insertionIndex < 2 * getInsertionsPerMachine(); ++insertionIndex)
+                candidates.push_back(getInsertion(insertionIndex, order));
+        return candidates;
+    }
+
+    std::vector<Move> generateSampledCandidates(const BlockOrder &order)
+    {
+        std::vector<Move> candidates;
+        for (auto &&swap : generateCandidatesForSwap()) candidates.push_back(Move::fromSwap(swap));
+        for (auto &&insertionIndex : sampleDistinct(settings->insertionSearchCount, 2 * getInsertionsPerMachine()))
+            candidates.push_back(getInsertion(insertionIndex, order));
+        return candidates;
+    }
+
+    std::vector<Move> generateCandidates(const BlockOrder &order)
+    {
+        return settings->neighbourhoodMode == utils::FULL ? generateAllCandidates(order) : generateSampledCandidates(order);
+    }
+
+    // the elite moves kept from earlier iterations followed by a fresh sample
+    std::vector<Move> generateEliteCandidates(const std::vector<Move> &eliteMoves, const BlockOrder &order, const std::vector<unsigned int> &positions)
+    {
+        std::vector<Move> candidates;
+        for (auto &&move : eliteMoves)
+        {
+            // earlier moves can have put the block where the insertion would
+            if(move.type == utils::INSERTION && positions[move.block] == move.target) continue;
+            candidates.push_back(move);
+        }
+        for (auto &&move : generateSampledCandidates(order))
+            if(std::find(eliteMoves.begin(), eliteMoves.end(), move) == eliteMoves.end()) candidates.push_back(move);
+        return candidates;
+    }
+
+    // Keeps the candidateListSize best admissible moves except the one just made and returns the Cmax of the worst of them.
+    // The scan evaluates that many admissible moves besides the best one exactly, so they rank by their real Cmax.
+    template <typename Predicate>
+    unsigned int selectEliteMoves(std::vector<MoveListEntry> &entries, const Move &madeMove, Predicate isAdmissible, std::vector<Move> &eliteMoves)
+    {
+        auto last = std::remove_if(entries.begin(), entries.end(), [&](const MoveListEntry &entry){ return entry.move == madeMove || !isAdmissible(entry); });
+        std::size_t kept = std::min<std::size_t>(settings->candidateListSize, last - entries.begin());
+        std::partial_sort(entries.begin(), entries.begin() + kept, last, [](const MoveListEntry &x, const MoveListEntry &y){ return x.cMax < y.cMax; });
+        eliteMoves.clear();
+        for (std::size_t entry = 0; entry < kept; ++entry) eliteMoves.push_back(entries[entry].move);
+        return kept > 0 ? entries[kept - 1].cMax : 0;
+    }
+
+    void insert(BlockIndex block, unsigned int target, BlockOrder &order, std::vector<unsigned int> &positions)
+    {
+        unsigned int position = positions[block];
+        if(position < target) std::rotate(order.begin() + position, order.begin() + position + 1, order.begin() + target + 1);
+        else std::rotate(order.begin() + target, order.begin() + position, order.begin() + position + 1);
+        for (unsigned int current = std::min(position, target); current <= std::max(position, target); ++current)
+            positions[order[current]] = current;
+    }
+
+    // Applies `move` and returns the first position of the order it changed
+    unsigned int applyMove(const Move &move, BlockOrder &order, std::vector<unsigned int> &positions)
+    {
+        unsigned int firstChangedPosition = std::min(positions[move.block], move.type == utils::SWAP ? positions[move.target] : move.target);
+        if(move.type == utils::SWAP) swap(std::make_pair(move.block, move.target), order, positions);
+        else insert(move.block, move.target, order, positions);
+        return firstChangedPosition;
+    }
+
+    // FNV-1a over the block indices, equal orders decode to equal schedules
+    static std::uint64_t getOrderHash(const BlockOrder &order)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325;
+        for (auto &&block : order) hash = (hash ^ block) * 0x100000001b3;
+        return hash;
+    }
+
+    // random swaps made tabu so the search does not walk straight back
+    void escape(unsigned int length, BlockOrder &order, std::vector<unsigned int> &positions, TabuList &tabuList)
+    {
+        for (unsigned int step = 0; step < length; ++step)
+        {
+            BlockSwap randomSwap = getRandomSwap(*settings, randomGenerator);
+            swap(randomSwap, order, positions);
+            tabuList.push(TabuList::getMoveKey(randomSwap));
+        }
+        currentSolution.clear();
+        currentSolution.orderedSolution(order);
+        incumbent->offer(currentSolution);
+        updateRetryBest(order);
+    }
+
+    // Walks from `current` to `guide` by swaps that each put at least one block where the guide has it. Every step takes
+    // the best of at most neighbourSearchCount such swaps, the best intermediate order is returned with its Cmax.
+    EliteSolution relinkPath(BlockOrder current, const BlockOrder &guide)
+    {
+        std::vector<unsigned int> positions = getBlockPositions(current);
+        std::vector<unsigned int> differing;
+        for (unsigned int position = 0; position < current.size(); ++position)
+            if(current[position] != guide[position]) differing.push_back(position);
+
+        std::vector<MakespanEvaluator> evaluators(workers.size(), MakespanEvaluator(*settings));
+        Solution decodedOrder(*settings);
+        std::vector<DecodeCheckpoint> checkpoints;
+        std::vector<MoveListEntry> steps;
+        EliteSolution best{current, std::numeric_limits<unsigned int>::max()};
+        // the last step reaches the guide itself
+        while (differing.size() > 2)
+        {
+            if(deadline && deadline->hasPassed()) break;
+            decodedOrder.clear();
+            checkpoints.clear();
+            decodedOrder.orderedSolution(current.begin(), current.end(), &checkpoints);
+            for (auto &&evaluator : evaluators) evaluator.setDecodedOrder(decodedOrder, checkpoints);
+
+            std::vector<std::uint64_t> sampled = sampleDistinct(settings->neighbourSearchCount, differing.size());
+            steps.resize(sampled.size());
+            std::atomic<unsigned int> bestStepCmax{std::numeric_limits<unsigned int>::max()};
+            workers.parallelFor(sampled.size(), [&](unsigned int worker, std::size_t index)
+            {
+                unsigned int position = differing[sampled[index]];
+                MoveListEntry &step = steps[index];
+                step.move = Move::fromSwap(std::make_pair(current[position], guide[position]));
+                unsigned int bound = bestStepCmax.load(std::memory_order_relaxed);
+                step.cMax = evaluators[worker].evaluateMove(current, positions, step.move, bound);
+                while (step.cMax < bound && !bestStepCmax.compare_exchange_weak(bound, step.cMax, std::memory_order_relaxed));
+            });
+            const MoveListEntry &bestStep = *std::min_element(steps.begin(), steps.end(), [](const MoveListEntry &x, const MoveListEntry &y){ return x.cMax < y.cMax; });
+            applyMove(bestStep.move, current, positions);
+            if(bestStep.cMax < best.cMax) best = {current, bestStep.cMax};
+            differing.erase(std::remove_if(differing.begin(), differing.end(), [&](unsigned int position){ return current[position] == guide[position]; }), differing.end());
+        }
+        return best;
+    }
+
+    // Relinks the best order of the retry with every other member of the pool. Orders that beat both ends are offered
+    // to the incumbent and the pool.
+    void relink(ElitePool &elitePool)
+    {
+        for (auto &&member : elitePool.getMembers())
+        {
+            if(ElitePool::getDistance(retryBestOrder, member.order) == 0) continue;
+            EliteSolution relinked = relinkPath(retryBestOrder, member.order);
+            if(relinked.cMax >= std::min(retryBestCmax, member.cMax)) continue;
+            currentSolution.clear();
+            currentSolution.orderedSolution(relinked.order);
+            incumbent->offer(currentSolution);
+            elitePool.offer(relinked.order, relinked.cMax);
+        }
+    }
+
+    // A candidate move is tabu if it is in the tabu list under this key
+    std::uint64_t getTabuKey(const Move &move)
+    {
+        if(move.type == utils::SWAP) return TabuList::getMoveKey(std::make_pair(move.block, move.target));
+        return TabuList::getInsertionKey(move.block, move.target);
+    }
+
+    // Key that makes undoing `move` tabu once it is applied: swapping the same blocks again or moving the block back
+    std::uint64_t getReverseTabuKey(const Move &move, const std::vector<unsigned int> &positions)
+    {
+        if(move.type == utils::SWAP) return TabuList::getMoveKey(std::make_pair(move.block, move.target));
+        return TabuList::getInsertionKey(move.block, positions[move.block]);
+    }
+
+    void optimizeLocaly()
+    {
+        TabuList tabuList(settings->tabuListSize);
+        std::optional<ReactiveTenure> reactiveTenure;
+        // tenure can grow up to the number of swaps on one machine
+        if(settings->reactiveTabu) reactiveTenure.emplace(settings->tabuListSize, std::max<std::uint64_t>(settings->tabuListSize, getSwapsPerMachine()));
+        ConvergenceWindow convergence(settings->convergenceWindow);
+        // one evaluator per worker thread, they only share the read-only decoded order
+        std::vector<MakespanEvaluator> evaluators(workers.size(), MakespanEvaluator(*settings));
+        std::vector<MoveListEntry> localSearch;
+        Solution decodedOrder(*settings);
+        std::vector<DecodeCheckpoint> checkpoints;
+        // candidate list of the elite neighbourhood, empty when the next iteration scans the whole neighbourhood
+        std::vector<Move> eliteMoves;
+        unsigned int eliteThreshold = 0;
+        do
+        {
+            BlockOrder blocks = getBlocksOrder(*settings, currentSolution);
+            std::vector<unsigned int> positions = getBlockPositions(blocks);
+            if(reactiveTenure)
+            {
+                if(settings->tasks.size() > 1 && reactiveTenure->visit(getOrderHash(blocks), iterations))
+                    escape(reactiveTenure->getEscapeLength(), blocks, positions, tabuList);
+                tabuList.setTenure(reactiveTenure->getTenure());
+            }
+            decodedOrder.clear();
+            checkpoints.clear();
+            decodedOrder.orderedSolution(blocks.begin(), blocks.end(), &checkpoints);
+            std::vector<Move> moveList;
+            bool fullScan = eliteMoves.empty();
+            if(settings->neighbourhoodMode == utils::CRITICAL) moveList = generateCriticalCandidates(decodedOrder, positions);
+            else if(settings->neighbourhoodMode == utils::ELITE) moveList = fullScan ? generateAllCandidates(blocks) : generateEliteCandidates(eliteMoves, blocks, positions);
+            else moveList = generateCandidates(blocks);
+            if(moveList.empty()) return;
+            for (auto &&evaluator : evaluators) evaluator.setDecodedOrder(decodedOrder, checkpoints);
+            localSearch.resize(moveList.size());
+            //a move is admissible if it is not in tabu OR its cMax is better than in best solution
+            unsigned int aspirationCmax = incumbent->getCmax();
+            auto isAdmissible = [&](const MoveListEntry &entry){ return !tabuList.contains(getTabuKey(entry.move)) || entry.cMax < aspirationCmax; };
+            // candidates whose partial Cmax exceeds the best admissible Cmax found so far cannot be selected,
+            // ties are evaluated fully so the selection does not depend on evaluation order. The elite neighbourhood
+            // also keeps the next candidateListSize admissible moves, it prunes against the worst of them instead.
+            CmaxRanking admissibleRanking(settings->neighbourhoodMode == utils::ELITE ? settings->candidateListSize + 1 : 1);
+            // one scan of a large neighbourhood can take longer than the whole time limit, it is abandoned once the
+            // deadline passes and the current solution stays as it is
+            workers.parallelFor(moveList.size(), [&](unsigned int worker, std::size_t index)
+            {
+                MoveListEntry &entry = localSearch[index];
+                if(deadline && deadline->hasPassed(index)) return;
+                unsigned int bound = admissibleRanking.getBound();
+                entry.cMax = evaluators[worker].evaluateMove(blocks, positions, moveList[index], bound);
+                entry.move = moveList[index];
+                if(entry.cMax < bound && isAdmissible(entry)) admissibleRanking.offer(entry.cMax);
+            });
+            if(deadline && deadline->hasPassed()) return;
+            //take the best admissible move
+            const MoveListEntry* bestAdmissibleEntry = nullptr;
+            for (auto &&swapEntry : localSearch)
+            {
+                if(bestAdmissibleEntry && swapEntry.cMax >= bestAdmissibleEntry->cMax) continue;
+                if(isAdmissible(swapEntry)) bestAdmissibleEntry = &swapEntry;
+            }
+            // every candidate is tabu: move anyway instead of stalling
+            if(!bestAdmissibleEntry)
+                bestAdmissibleEntry = &*std::min_element(localSearch.begin(), localSearch.end(), [](const MoveListEntry &x, const MoveListEntry &y){ return x.cMax < y.cMax; });
+            MoveListEntry bestEntry = *bestAdmissibleEntry;
+            convergence.push(bestEntry.cMax);
+            if(settings->neighbourhoodMode == utils::ELITE)
+            {
+                unsigned int worstEliteCmax = selectEliteMoves(localSearch, bestEntry.move, isAdmissible, eliteMoves);
+                if(fullScan) eliteThreshold = worstEliteCmax;
+                // the list no longer yields moves as good as the ones the last full scan kept, scan everything again
+                else if(bestEntry.cMax > eliteThreshold) eliteMoves.clear();
+            }
+            tabuList.push(getReverseTabuKey(bestEntry.move, positions));
+            // blocks before the first changed position decode exactly as in the current order
+            unsigned int firstChangedPosition = applyMove(bestEntry.move, blocks, positions);
+            currentSolution.restoreCheckpoint(decodedOrder, checkpoints[firstChangedPosition]);
+            currentSolution.orderedSolution(blocks.cbegin() + firstChangedPosition, blocks.cend());
+            incumbent->offer(currentSolution);
+            updateRetryBest(blocks);
+            ++iterations;
+            
+        } while (!convergence.isFull() || convergence.getStandardDeviation() > settings->convergenceThreshold);
+    }
+
+};
+
+// Simulated annealing over block orders decoded like the tabu search ones, one random swap per step. A swap with
+// Cmax c is accepted with probability exp(-(c - currentCmax) / temperature): drawing u first turns that into
+// c <= currentCmax - temperature * ln(u), so the threshold bounds the evaluation of the swap.
+// The temperature follows the cooling schedule over annealingSteps steps, or over the whole time limit when there is one.
+template <typename RandomGenerator = utils::Xoshiro256PlusPlus>
+class SimulatedAnnealing
+{
+private:
+    RandomGenerator randomGenerator;
+    const ProblemInstance* settings;
+    SharedIncumbent* incumbent;
+    Deadline* deadline;
+    MakespanEvaluator evaluator;
+    BlockOrder order;
+    std::vector<unsigned int> positions;
+    // decodedOrder is the current solution, checkpoints are taken before every block of it
+    Solution decodedOrder;
+    Solution scratch;
+    std::vector<DecodeCheckpoint> checkpoints;
+
+public:
+    std::uint64_t iterations = 0;
+    SimulatedAnnealing(const ProblemInstance &settings, SharedIncumbent &incumbent, const RandomGenerator &randomGenerator, Deadline* deadline = nullptr)
+    :randomGenerator(randomGenerator), settings(&settings), incumbent(&incumbent), deadline(deadline), evaluator(settings), decodedOrder(settings), scratch(settings){}
+
+    SimulatedAnnealing& createInitialSolution()
+    {
+        scratch.clear();
+        scratch.randomSolution(createRandomOrder(*settings, randomGenerator));
+        order = getBlocksOrder(*settings, scratch);
+        positions = getBlockPositions(order);
+
+        decodedOrder.clear();
+        checkpoints.clear();
+        decodedOrder.orderedSolution(order.cbegin(), order.cend(), &checkpoints);
+        evaluator.setDecodedOrder(decodedOrder, checkpoints);
+        incumbent->offer(decodedOrder);
+        return *this;
+    }
+
+    // decodes the order again from `position` on
+    void decodeFrom(unsigned int position)
+    {
+        scratch.restoreCheckpoint(decodedOrder, checkpoints[position]);
+        checkpoints.resize(position);
+        scratch.orderedSolution(order.cbegin() + position, order.cend(), &checkpoints);
+        std::swap(decodedOrder, scratch);
+    }
+
+    // a temperature at which an average worsening swap is accepted with probability 1/2
+    double estimateInitialTemperature()
+    {
+        const unsigned int samples = 100;
+        std::uint64_t worsening = 0;
+        unsigned int worseningCount = 0;
+        for (unsigned int sample = 0; sample < samples; ++sample)
+        {
+            unsigned int cMax = evaluator.evaluateSwap(order, positions, getRandomSwap(*settings, randomGenerator));
+            if(cMax <= decodedOrder.getCmax()) continue;
+            worsening += cMax - decodedOrder.getCmax();
+            ++worseningCount;
+        }
+        if(worseningCount == 0) return 1;
+        return double(worsening) / worseningCount / std::log(2.0);
+    }
+
+    void anneal()
+    {
+        if(settings->tasks.size() < 2) return;
+        const double initialTemperature = settings->initialTemperature > 0 ? settings->initialTemperature : estimateInitialTemperature();
+        const double finalTemperature = std::min<double>(std::max(settings->finalTemperature, 1e-3f), initialTemperature);
+        auto getTemperature = [&](double progress)
+        {
+            if(settings->coolingSchedule == utils::LINEAR) return initialTemperature + (finalTemperature - initialTemperature) * progress;
+            // 1 / temperature grows linearly, as with T(k + 1) = T(k) / (1 + beta * T(k))
+            if(settings->coolingSchedule == utils::LUNDY_MEES) return 1 / (1 / initialTemperature + (1 / finalTemperature - 1 / initialTemperature) * progress);
+            return initialTemperature * std::pow(finalTemperature / initialTemperature, progress);
+        };
+        const bool timed = deadline && deadline->isLimited();
+        const unsigned int steps = std::max(1u, settings->annealingSteps);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        double temperature = initialTemperature;
+        double progress = 0;
+        for (std::uint64_t step = 1; progress < 1; ++step)
+        {
+            BlockSwap randomSwap = getRandomSwap(*settings, randomGenerator);
+            // 1 - u lies in (0, 1], its logarithm is finite
+            double threshold = decodedOrder.getCmax() - temperature * std::log(1.0 - uniform(randomGenerator));
+            unsigned int bound = threshold < std::numeric_limits<unsigned int>::max() ? static_cast<unsigned int>(threshold) : std::numeric_limits<unsigned int>::max() - 1;
+            if(evaluator.evaluateSwap(order, positions, randomSwap, bound) <= bound)
+            {
+                unsigned int firstChangedPosition = std::min(positions[randomSwap.first], positions[randomSwap.second]);
+                swap(randomSwap, order, positions);
+                decodeFrom(firstChangedPosition);
+                incumbent->offer(decodedOrder);
+            }
+
+            ++iterations;
+            if(!timed) progress = double(step) / steps;
+            else if(step % Deadline::checkInterval == 0) progress = deadline->getProgress();
+            temperature = getTemperature(progress);
+        }
+    }
+};
+
+// Genetic algorithm over block orders as createRandomOrder makes them, decoded with orderedSolution. Crossover works per
+// machine: the child takes the positions of machine 1 blocks from the first parent and fills the blocks of each machine
+// by order crossover (OX) of the parents' sequences on that machine. Mutation swaps two blocks of one machine.
+// Only the fitness of the population is computed in parallel, the random choices stay on the calling thread.
+template <typename RandomGenerator = utils::Xoshiro256PlusPlus>
+class GeneticAlgorithm
+{
+private:
+    struct Individual
+    {
+        BlockOrder order;
+        unsigned int cMax = 0;
+    };
+
+    RandomGenerator randomGenerator;
+    const ProblemInstance* settings;
+    SharedIncumbent* incumbent;
+    Deadline* deadline;
+    WorkerPool workers;
+    // one decoder per worker thread
+    std::vector<Solution> decoders;
+    std::vector<Individual> population;
+    std::vector<Individual> offspring;
+
+public:
+    std::uint64_t iterations = 0;
+    GeneticAlgorithm(const ProblemInstance &settings, SharedIncumbent &incumbent, const RandomGenerator &randomGenerator, unsigned int threads = 1, Deadline* deadline = nullptr)
+    :randomGenerator(randomGenerator), settings(&settings), incumbent(&incumbent), deadline(deadline), workers(threads), decoders(workers.size(), Solution(settings)){}
+
+    void evaluate(std::vector<Individual> &individuals)
+    {
+        workers.parallelFor(individuals.size(), [&](unsigned int worker, std::size_t index)
+        {
+            Solution &decoder = decoders[worker];
+            decoder.clear();
+            decoder.orderedSolution(individuals[index].order);
+            individuals[index].cMax = decoder.getCmax();
+        });
+    }
+
+    // OX: a random slice of `first` stays in place, the other positions get the remaining blocks in the order they follow
+    // the slice in `second`
+    std::vector<BlockIndex> crossOrders(const std::vector<BlockIndex> &first, const std::vector<BlockIndex> &second)
+    {
+        std::size_t size = first.size();
+        std::size_t sliceStart = std::uniform_int_distribution<std::size_t>(0, size - 1)(randomGenerator);
+        std::size_t sliceEnd = std::uniform_int_distribution<std::size_t>(sliceStart, size - 1)(randomGenerator) + 1;
+        std::vector<BlockIndex> child(size);
+        std::unordered_set<BlockIndex> inSlice(first.begin() + sliceStart, first.begin() + sliceEnd);
+        std::copy(first.begin() + sliceStart, first.begin() + sliceEnd, child.begin() + sliceStart);
+        std::size_t target = sliceEnd % size;
+        for (std::size_t offset = 0; offset < size; ++offset)
+        {
+            BlockIndex block = second[(sliceEnd + offset) % size];
+            if(inSlice.count(block)) continue;
+            child[target] = block;
+            target = (target + 1) % size;
+        }
+        return child;
+    }
+
+    BlockOrder crossover(const BlockOrder &first, const BlockOrder &second)
+    {
+        BlockOrder child(first.size());
+        for (auto &&machineNumber : {utils::MACHINE1, utils::MACHINE2})
+        {
+            auto isOnMachine = [&](BlockIndex block){ return settings->blocks[block].machineNumber == machineNumber; };
+            std::vector<BlockIndex> firstSequence, secondSequence;
+            std::copy_if(first.begin(), first.end(), std::back_inserter(firstSequence), isOnMachine);
+            std::copy_if(second.begin(), second.end(), std::back_inserter(secondSequence), isOnMachine);
+            std::vector<BlockIndex> childSequence = crossOrders(firstSequence, secondSequence);
+            auto next = childSequence.begin();
+            for (std::size_t position = 0; position < first.size(); ++position)
+                if(isOnMachine(first[position])) child[position] = *next++;
+        }
+        return child;
+    }
+
+    // binary tournament
+    const Individual& selectParent()
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, population.size() - 1);
+        const Individual &first = population[pick(randomGenerator)];
+        const Individual &second = population[pick(randomGenerator)];
+        return first.cMax <= second.cMax ? first : second;
+    }
+
+    void offerBest()
+    {
+        const Individual &best = *std::min_element(population.begin(), population.end(), [](const Individual &x, const Individual &y){ return x.cMax < y.cMax; });
+        if(best.cMax >= incumbent->getCmax()) return;
+        decoders[0].clear();
+        decoders[0].orderedSolution(best.order);
+        incumbent->offer(decoders[0]);
+    }
+
+    void run()
+    {
+        if(settings->tasks.size() < 2)
+        {
+            // nothing to recombine, the only order is the solution
+            decoders[0].clear();
+            decoders[0].orderedSolution(createRandomOrder(*settings, randomGenerator));
+            incumbent->offer(decoders[0]);
+            return;
+        }
+        std::size_t populationSize = std::max(2u, settings->populationSize);
+        population.resize(populationSize);
+        for (auto &&individual : population) individual.order = createRandomOrder(*settings, randomGenerator);
+        evaluate(population);
+        offerBest();
+
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        const bool timed = deadline && deadline->isLimited();
+        for (unsigned int generation = 0; timed || generation < settings->generations; ++generation)
+        {
+            // the best individual survives as it is
+            std::iter_swap(population.begin(), std::min_element(population.begin(), population.end(), [](const Individual &x, const Individual &y){ return x.cMax < y.cMax; }));
+            offspring.resize(populationSize - 1);
+            for (auto &&child : offspring)
+            {
+                child.order = crossover(selectParent().order, selectParent().order);
+                if(uniform(randomGenerator) < settings->mutationRate)
+                {
+                    std::vector<unsigned int> positions = getBlockPositions(child.order);
+                    swap(getRandomSwap(*settings, randomGenerator), child.order, positions);
+                }
+            }
+            evaluate(offspring);
+            std::move(offspring.begin(), offspring.end(), population.begin() + 1);
+            offerBest();
+            ++iterations;
+            if(deadline && deadline->hasPassed()) return;
+        }
+    }
+};
+
+// Link of this island to the ring of islands: migrants go to the next island, immigrants come from the previous one.
+// Every migration is one connection carrying a line of JSON per order, {"cMax": ..., "order": [...]}. Island i listens
+// on <prefix>.i for Unix domain sockets, and for TCP on the i-th address of a comma separated list or on the port of
+// a single address plus i. An island that cannot listen runs without migration.
+class IslandLink
+{
+private:
+    const ProblemInstance* settings;
+    int listener = -1;
+    std::string socketPath;
+    std::thread receiver;
+    std::atomic<bool> stopping{false};
+    std::mutex mutex;
+    std::vector<BlockOrder> immigrants;
+
+    std::string getAddress() const
+    {
+        if(!settings->migrationAddress.empty()) return settings->migrationAddress;
+        return settings->migrationTransport == utils::UNIX_SOCKET ? "/tmp/tabu-search-island" : "127.0.0.1:47000";
+    }
+
+    bool resolve(unsigned int island, sockaddr_storage &address, socklen_t &length) const
+    {
+        std::memset(&address, 0, sizeof(address));
+        if(settings->migrationTransport == utils::UNIX_SOCKET)
+        {
+            sockaddr_un &unixAddress = reinterpret_cast<sockaddr_un&>(address);
+            std::string path = getAddress() + "." + std::to_string(island);
+            if(path.size() >= sizeof(unixAddress.sun_path)) return false;
+            unixAddress.sun_family = AF_UNIX;
+            std::strcpy(unixAddress.sun_path, path.c_str());
+            length = sizeof(sockaddr_un);
+            return true;
+        }
+
+        std::vector<std::string> endpoints;
+        std::istringstream list(getAddress());
+        for (std::string endpoint; std::getline(list, endpoint, ',');) endpoints.push_back(endpoint);
+        if(endpoints.empty() || (endpoints.size() > 1 && island >= endpoints.size())) return false;
+        const std::string &endpoint = endpoints.size() > 1 ? endpoints[island] : endpoints[0];
+        std::size_t colon = endpoint.rfind(':');
+        if(colon == std::string::npos) return false;
+        unsigned long port = std::strtoul(endpoint.c_str() + colon + 1, NULL, 10) + (endpoints.size() > 1 ? 0 : island);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = nullptr;
+        if(getaddrinfo(endpoint.substr(0, colon).c_str(), std::to_string(port).c_str(), &hints, &result) != 0) return false;
+        std::memcpy(&address, result->ai_addr, result->ai_addrlen);
+        length = result->ai_addrlen;
+        freeaddrinfo(result);
+        return true;
+    }
+
+    // a permutation of every block of the instance laid out as getBlocksOrder lays it out, the machine 1 blocks first.
+    // Relinking, insertions and the frequency memory rely on that layout.
+    bool isValidOrder(const BlockOrder &order) const
+    {
+        if(order.size() != settings->blocks.size()) return false;
+        std::vector<bool> seen(order.size());
+        for (unsigned int position = 0; position < order.size(); ++position)
+        {
+            BlockIndex block = order[position];
+            if(block >= order.size() || seen[block]) return false;
+            if((settings->blocks[block].machineNumber == utils::MACHINE1) != (position < settings->tasks.size())) return false;
+            seen[block] = true;
+        }
+        return true;
+    }
+
+    void receive()
+    {
+        while (!stopping)
+        {
+            int connection = accept(listener, nullptr, nullptr);
+            if(connection < 0)
+            {
+                if(errno == EINTR || errno == ECONNABORTED) continue;
+                // the listener is closed or no longer a socket
+                if(errno == EBADF || errno == EINVAL || errno == ENOTSOCK) return;
+                // out of descriptors or memory, wait for some to be released instead of spinning
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                continue;
+            }
+            timeval timeout{1, 0};
+            setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            // a migration carries at most migrationCount orders of blocks.size() indices, a peer sending more is dropped
+            const std::size_t messageLimit = std::max(1u, settings->migrationCount) * (settings->blocks.size() * 16 + 64);
+            std::string message;
+            char buffer[4096];
+            for (ssize_t received; message.size() <= messageLimit && (received = read(connection, buffer, sizeof(buffer))) > 0;) message.append(buffer, received);
+            close(connection);
+            if(message.size() > messageLimit) continue;
+
+            std::istringstream lines(message);
+            for (std::string line; std::getline(lines, line);)
+            {
+                Json migrant = Json::parse(line, nullptr, false);
+                if(migrant.is_discarded() || !migrant.is_object() || !migrant.contains("order") || !migrant["order"].is_array()) continue;
+                BlockOrder order;
+                for (auto &&block : migrant["order"])
+                    if(block.is_number_unsigned()) order.push_back(block.get<BlockIndex>());
+                if(!isValidOrder(order)) continue;
+                std::lock_guard<std::mutex> lock(mutex);
+                immigrants.push_back(std::move(order));
+            }
+        }
+    }
+
+public:
+    std::atomic<unsigned int> sent{0};
+    std::atomic<unsigned int> received{0};
+
+    IslandLink(const ProblemInstance &settings):settings(&settings)
+    {
+        sockaddr_storage address;
+        socklen_t length;
+        if(!resolve(settings.islandId, address, length))
+        {
+            std::cerr << "Invalid migration address: " << getAddress() << ", running without migration" << std::endl;
+            return;
+        }
+        if(settings.migrationTransport == utils::UNIX_SOCKET)
+        {
+            socketPath = reinterpret_cast<sockaddr_un&>(address).sun_path;
+            unlink(socketPath.c_str());
+        }
+        listener = socket(address.ss_family, SOCK_STREAM, 0);
+        int reuse = 1;
+        if(settings.migrationTransport == utils::TCP) setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if(listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address), length) != 0 || listen(listener, 16) != 0)
+        {
+            std::cerr << "Island " << settings.islandId << " cannot listen: " << std::strerror(errno) << ", running without migration" << std::endl;
+            if(listener >= 0) close(listener);
+            listener = -1;
+            return;
+        }
+        receiver = std::thread(&IslandLink::receive, this);
+    }
+
+    ~IslandLink()
+    {
+        stopping = true;
+        if(listener >= 0)
+        {
+            shutdown(listener, SHUT_RDWR);
+            receiver.join();
+            close(listener);
+        }
+        if(!socketPath.empty()) unlink(socketPath.c_str());
+    }
+
+    bool isConnected() const
+    {
+        return listener >= 0;
+    }
+
+    // sends the orders to the next island, skipped when it is not listening
+    void emigrate(const std::vector<EliteSolution> &migrants)
+    {
+        sockaddr_storage address;
+        socklen_t length;
+        if(migrants.empty() || !resolve((settings->islandId + 1) % settings->islandCount, address, length)) return;
+        int connection = socket(address.ss_family, SOCK_STREAM, 0);
+        if(connection < 0) return;
+        timeval timeout{1, 0};
+        setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        if(connect(connection, reinterpret_cast<sockaddr*>(&address), length) == 0)
+        {
+            std::string message;
+            for (auto &&migrant : migrants) message += Json{{"cMax", migrant.cMax}, {"order", migrant.order}}.dump() + '\n';
+            std::size_t written = 0;
+            for (ssize_t count; written < message.size() && (count = ::send(connection, message.data() + written, message.size() - written, MSG_NOSIGNAL)) > 0;)
+                written += count;
+            if(written == message.size()) sent += migrants.size();
+        }
+        close(connection);
+    }
+
+    std::vector<BlockOrder> takeImmigrants()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        received += immigrants.size();
+        return std::move(immigrants);
+    }
+};
+
+// Runs the algorithm retries concurrently. Every retry thread owns a TabuSearch, SimulatedAnnealing or GeneticAlgorithm with
+// its own random stream jumped off the seed, threads left over when there are fewer retries than threads evaluate tabu
+// neighbourhoods or populations.
+class MultiStartSearch
+{
+private:
+    const ProblemInstance* settings;
+    std::atomic<unsigned int> nextRetry{0};
+    Deadline deadline;
+    utils::Xoshiro256PlusPlus streams;
+    std::optional<FrequencyMemory> memory;
+    std::optional<ElitePool> elitePool;
+    std::mutex restartOrdersMutex;
+    // immigrants waiting to start a retry
+    std::deque<BlockOrder> restartOrders;
+
+    std::optional<BlockOrder> takeRestartOrder()
+    {
+        std::lock_guard<std::mutex> lock(restartOrdersMutex);
+        if(restartOrders.empty()) return std::nullopt;
+        BlockOrder order = std::move(restartOrders.front());
+        restartOrders.pop_front();
+        return order;
+    }
+
+    // The best migrationCount members of the pool leave for the next island, immigrants that arrived since the last
+    // migration are offered to the incumbent and the pool
+    void migrate()
+    {
+        std::vector<EliteSolution> migrants = elitePool->getMembers();
+        std::size_t count = std::min<std::size_t>(settings->migrationCount, migrants.size());
+        std::partial_sort(migrants.begin(), migrants.begin() + count, migrants.end(), [](const EliteSolution &x, const EliteSolution &y){ return x.cMax < y.cMax; });
+        migrants.resize(count);
+        islandLink->emigrate(migrants);
+
+        Solution decoded(*settings);
+        for (auto &&order : islandLink->takeImmigrants())
+        {
+            decoded.clear();
+            decoded.orderedSolution(order);
+            incumbent.offer(decoded);
+            elitePool->offer(order, decoded.getCmax());
+            if(settings->migrationReplacement != utils::REPLACE_RESTART) continue;
+            std::lock_guard<std::mutex> lock(restartOrdersMutex);
+            restartOrders.push_back(std::move(order));
+        }
+    }
+
+    bool hasNextRetry(unsigned int retry)
+    {
+        if(deadline.isLimited()) return !deadline.hasPassed();
+        return retry < settings->algorithmRetries;
+    }
+
+    void runAnnealingRetries(utils::Xoshiro256PlusPlus randomGenerator)
+    {
+        SimulatedAnnealing<> algorithm(*settings, incumbent, randomGenerator, &deadline);
+        for (unsigned int retry = nextRetry++; hasNextRetry(retry); retry = nextRetry++)
+        {
+            algorithm.createInitialSolution();
+            algorithm.anneal();
+            ++restarts;
+            printf("[Retry %d] Best Solution: %d\n", retry, incumbent.getCmax());
+        }
+        iterations += algorithm.iterations;
+    }
+
+    void runGeneticRetries(unsigned int threads, utils::Xoshiro256PlusPlus randomGenerator)
+    {
+        GeneticAlgorithm<> algorithm(*settings, incumbent, randomGenerator, threads, &deadline);
+        for (unsigned int retry = nextRetry++; hasNextRetry(retry); retry = nextRetry++)
+        {
+            algorithm.run();
+            ++restarts;
+            printf("[Retry %d] Best Solution: %d\n", retry, incumbent.getCmax());
+        }
+        iterations += algorithm.iterations;
+    }
+
+    void runRetries(unsigned int neighbourThreads, utils::Xoshiro256PlusPlus randomGenerator)
+    {
+        if(settings->algorithm == utils::SIMULATED_ANNEALING) return runAnnealingRetries(randomGenerator);
+        if(settings->algorithm == utils::GENETIC_ALGORITHM) return runGeneticRetries(neighbourThreads, randomGenerator);
+        TabuSearch<> algorithm(*settings, incumbent, randomGenerator, neighbourThreads, &deadline);
+        algorithm.createInitialSolution();
+        incumbent.offer(algorithm.currentSolution);
+        for (unsigned int retry = nextRetry++; hasNextRetry(retry); retry = nextRetry++)
+        {
+            // restarts wait for random ones until the memory has something to offer
+            std::optional<BlockOrder> restartOrder = takeRestartOrder();
+            if(restartOrder) algorithm.createInitialSolution(*restartOrder);
+            else if(memory && memory->getRecords() > 0)
+            {
+                bool intensify = settings->restartMode == utils::INTENSIFY || (settings->restartMode == utils::ALTERNATE && retry % 2 == 1);
+                algorithm.createInitialSolution(*memory, intensify);
+            }
+            else algorithm.createInitialSolution();
+            algorithm.optimizeLocaly();
+            if(memory) memory->record(algorithm.retryBestOrder);
+            if(elitePool)
+            {
+                elitePool->offer(algorithm.retryBestOrder, algorithm.retryBestCmax);
+                if(settings->elitePoolSize > 0) algorithm.relink(*elitePool);
+            }
+            unsigned int finishedRetries = ++restarts;
+            if(islandLink && islandLink->isConnected() && finishedRetries % std::max(1u, settings->migrationInterval) == 0) migrate();
+            printf("[Retry %d] Best Solution: %d\n", retry, incumbent.getCmax());
+        }
+        iterations += algorithm.iterations;
+    }
+
+public:
+    SharedIncumbent incumbent;
+    std::atomic<unsigned int> restarts{0};
+    std::atomic<std::uint64_t> iterations{0};
+    std::optional<IslandLink> islandLink;
+    MultiStartSearch(const ProblemInstance &settings):settings(&settings), deadline(settings.timeLimitMs), streams(settings.seed.value_or(0))
+    {
+        if(settings.restartMode != utils::RANDOM) memory.emplace(settings.tasks.size());
+        // islands migrate the best members of an elite pool, which then has to hold at least migrationCount orders
+        unsigned int elitePoolSize = settings.elitePoolSize;
+        if(settings.islandCount > 1 && settings.algorithm == utils::TABU_SEARCH)
+        {
+            elitePoolSize = std::max(elitePoolSize, std::max(1u, settings.migrationCount));
+            islandLink.emplace(settings);
+        }
+        // members have to differ in at least a tenth of the positions, a single swap changes two
+        if(elitePoolSize > 0) elitePool.emplace(elitePoolSize, std::max<std::size_t>(2, settings.blocks.size() / 10));
+        // every island draws from its own 2^64 streams
+        for (unsigned int island = 0; island < settings.islandId; ++island) streams.longJump();
+    }
+
+    // every call returns a stream that does not overlap any stream returned before
+    utils::Xoshiro256PlusPlus nextStream()
+    {
+        utils::Xoshiro256PlusPlus stream = streams;
+        streams.jump();
+        return stream;
+    }
+
+    void run()
+    {
+        // without a time limit there is no point in more retry threads than retries,
+        // the genetic algorithm runs its retries one by one and evaluates the population on every thread
+        unsigned int retryThreads = deadline.isLimited() ? std::max(1u, settings->threads) : std::max(1u, std::min(settings->threads, settings->algorithmRetries));
+        if(settings->algorithm == utils::GENETIC_ALGORITHM) retryThreads = 1;
+        unsigned int neighbourThreads = std::max(1u, settings->threads / retryThreads);
+        utils::Xoshiro256PlusPlus firstStream = nextStream();
+        std::vector<std::thread> threads;
+        for (unsigned int thread = 1; thread < retryThreads; ++thread)
+            threads.emplace_back(&MultiStartSearch::runRetries, this, neighbourThreads, nextStream());
+        runRetries(neighbourThreads, firstStream);
+        for (auto &&thread : threads) thread.join();
+    }
+};
+
+utils::NeighbourhoodMode parseNeighbourhoodMode(const std::string &mode)
+{
+    if(mode == "full") return utils::FULL;
+    if(mode == "critical") return utils::CRITICAL;
+    if(mode == "elite") return utils::ELITE;
+    if(mode != "sampled") std::cerr << "Unknown neighbourhood: " << mode << ", using sampled" << std::endl;
+    return utils::SAMPLED;
+}
+
+utils::RestartMode parseRestartMode(const std::string &mode)
+{
+    if(mode == "diversify") return utils::DIVERSIFY;
+    if(mode == "intensify") return utils::INTENSIFY;
+    if(mode == "alternate") return utils::ALTERNATE;
+    if(mode != "random") std::cerr << "Unknown restart mode: " << mode << ", using random" << std::endl;
+    return utils::RANDOM;
+}
+
+utils::Algorithm parseAlgorithm(const std::string &algorithm)
+{
+    if(algorithm == "annealing") return utils::SIMULATED_ANNEALING;
+    if(algorithm == "genetic") return utils::GENETIC_ALGORITHM;
+    if(algorithm != "tabu") std::cerr << "Unknown algorithm: " << algorithm << ", using tabu" << std::endl;
+    return utils::TABU_SEARCH;
+}
+
+utils::CoolingSchedule parseCoolingSchedule(const std::string &schedule)
+{
+    if(schedule == "linear") return utils::LINEAR;
+    if(schedule == "lundy-mees") return utils::LUNDY_MEES;
+    if(schedule != "geometric") std::cerr << "Unknown cooling schedule: " << schedule << ", using geometric" << std::endl;
+    return utils::GEOMETRIC;
+}
+
+utils::MigrationTransport parseMigrationTransport(const std::string &transport)
+{
+    if(transport == "tcp") return utils::TCP;
+    if(transport != "unix") std::cerr << "Unknown migration transport: " << transport << ", using unix" << std::endl;
+    return utils::UNIX_SOCKET;
+}
+
+utils::MigrationReplacement parseMigrationReplacement(const std::string &replacement)
+{
+    if(replacement == "restart") return utils::REPLACE_RESTART;
+    if(replacement != "worst") std::cerr << "Unknown migration replacement: " << replacement << ", using worst" << std::endl;
+    return utils::REPLACE_WORST;
+}
+
+ProblemInstance loadProblemInstance(const char* filepath)
+{
+    std::ifstream file(filepath);
+    Json jsonParser;
+    file >> jsonParser;
+    const Json &jsonTasks = jsonParser["tasks"];
+    std::vector<Task> tasks;
+    tasks.reserve(jsonTasks.size());
+    for (auto && task: jsonTasks.items())
+        tasks.emplace_back(std::strtoul(task.key().c_str(), NULL, 10), task.value()["1"].get<unsigned int>(), task.value()["2"].get<unsigned int>());
+
+    ProblemInstance instance(jsonParser["maintenanceLength"], jsonParser["maintenancePeriod"], jsonParser["neighbourSearchCount"],
+        jsonParser["algorithmRetries"], jsonParser["operationRenewPunishmentFactor"], std::move(tasks));
+    instance.threads = jsonParser.value("threads", instance.threads);
+    instance.insertionSearchCount = jsonParser.value("insertionSearchCount", instance.insertionSearchCount);
+    instance.candidateListSize = jsonParser.value("candidateListSize", instance.candidateListSize);
+    instance.tabuListSize = jsonParser.value("tabuListSize", instance.tabuListSize);
+    instance.reactiveTabu = jsonParser.value("reactiveTabu", instance.reactiveTabu);
+    instance.convergenceWindow = jsonParser.value("convergenceWindow", instance.convergenceWindow);
+    instance.convergenceThreshold = jsonParser.value("convergenceThreshold", instance.convergenceThreshold);
+    instance.timeLimitMs = jsonParser.value("timeLimitMs", instance.timeLimitMs);
+    if(jsonParser.contains("seed")) instance.seed = jsonParser["seed"].get<std::uint64_t>();
+    instance.elitePoolSize = jsonParser.value("elitePoolSize", instance.elitePoolSize);
+    instance.initialTemperature = jsonParser.value("initialTemperature", instance.initialTemperature);
+    instance.finalTemperature = jsonParser.value("finalTemperature", instance.finalTemperature);
+    instance.annealingSteps = jsonParser.value("annealingSteps", instance.annealingSteps);
+    instance.populationSize = jsonParser.value("populationSize", instance.populationSize);
+    instance.generations = jsonParser.value("generations", instance.generations);
+    instance.mutationRate = jsonParser.value("mutationRate", instance.mutationRate);
+    instance.islandCount = jsonParser.value("islandCount", instance.islandCount);
+    instance.islandId = jsonParser.value("islandId", instance.islandId);
+    instance.migrationAddress = jsonParser.value("migrationAddress", instance.migrationAddress);
+    instance.migrationInterval = jsonParser.value("migrationInterval", instance.migrationInterval);
+    instance.migrationCount = jsonParser.value("migrationCount", instance.migrationCount);
+    if(jsonParser.contains("migrationTransport")) instance.migrationTransport = parseMigrationTransport(jsonParser["migrationTransport"].get<std::string>());
+    if(jsonParser.contains("migrationReplacement")) instance.migrationReplacement = parseMigrationReplacement(jsonParser["migrationReplacement"].get<std::string>());
+    if(jsonParser.contains("algorithm")) instance.algorithm = parseAlgorithm(jsonParser["algorithm"].get<std::string>());
+    if(jsonParser.contains("cooling")) instance.coolingSchedule = parseCoolingSchedule(jsonParser["cooling"].get<std::string>());
+    if(jsonParser.contains("restarts")) instance.restartMode = parseRestartMode(jsonParser["restarts"].get<std::string>());
+    if(jsonParser.contains("neighbourhood")) instance.neighbourhoodMode = parseNeighbourhoodMode(jsonParser["neighbourhood"].get<std::string>());
+    return instance;
+}
+
+// Options given after the instance path override the values from the instance file
+void applyCommandLineOptions(ProblemInstance &settings, int argc, char const *argv[])
+{
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if(option == "--threads" && i + 1 < argc) settings.threads = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--insertions" && i + 1 < argc) settings.insertionSearchCount = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--tenure" && i + 1 < argc) settings.tabuListSize = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--restarts" && i + 1 < argc) settings.restartMode = parseRestartMode(argv[++i]);
+        else if(option == "--elite-pool" && i + 1 < argc) settings.elitePoolSize = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--algorithm" && i + 1 < argc) settings.algorithm = parseAlgorithm(argv[++i]);
+        else if(option == "--cooling" && i + 1 < argc) settings.coolingSchedule = parseCoolingSchedule(argv[++i]);
+        else if(option == "--initial-temperature" && i + 1 < argc) settings.initialTemperature = std::strtof(argv[++i], NULL);
+        else if(option == "--final-temperature" && i + 1 < argc) settings.finalTemperature = std::strtof(argv[++i], NULL);
+        else if(option == "--annealing-steps" && i + 1 < argc) settings.annealingSteps = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--population" && i + 1 < argc) settings.populationSize = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--generations" && i + 1 < argc) settings.generations = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--mutation-rate" && i + 1 < argc) settings.mutationRate = std::strtof(argv[++i], NULL);
+        else if(option == "--islands" && i + 1 < argc) settings.islandCount = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--island-id" && i + 1 < argc) settings.islandId = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--migration-transport" && i + 1 < argc) settings.migrationTransport = parseMigrationTransport(argv[++i]);
+        else if(option == "--migration-address" && i + 1 < argc) settings.migrationAddress = argv[++i];
+        else if(option == "--migration-interval" && i + 1 < argc) settings.migrationInterval = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--migration-count" && i + 1 < argc) settings.migrationCount = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--migration-replacement" && i + 1 < argc) settings.migrationReplacement = parseMigrationReplacement(argv[++i]);
+        else if(option == "--reactive") settings.reactiveTabu = true;
+        else if(option == "--candidates" && i + 1 < argc) settings.candidateListSize = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--neighbourhood" && i + 1 < argc) settings.neighbourhoodMode = parseNeighbourhoodMode(argv[++i]);
+        else if(option == "--convergence-window" && i + 1 < argc) settings.convergenceWindow = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--convergence-threshold" && i + 1 < argc) settings.convergenceThreshold = std::strtof(argv[++i], NULL);
+        else if(option == "--time-limit" && i + 1 < argc) settings.timeLimitMs = std::strtoul(argv[++i], NULL, 10);
+        else if(option == "--seed" && i + 1 < argc) settings.seed = std::strtoull(argv[++i], NULL, 10);
+        else std::cerr << "Unknown option: " << option << std::endl;
+    }
+    if(settings.threads == 0) settings.threads = std::max(1u, std::thread::hardware_concurrency());
+    if(!settings.seed)
+    {
+        std::random_device rd;
+        settings.seed = (std::uint64_t(rd()) << 32) | rd();
+    }
+}
+
+
+int main(int argc, char const *argv[])
+{
+    const char* filepath = argv[1];
+
+    ProblemInstance settings = loadProblemInstance(filepath);
+    applyCommandLineOptions(settings, argc, argv);
+    printf("Seed: %llu\n", static_cast<unsigned long long>(*settings.seed));
+    MultiStartSearch algorithm(settings);
+    algorithm.run();
+    printf("Restarts: %u, iterations: %llu\n", algorithm.restarts.load(), static_cast<unsigned long long>(algorithm.iterations.load()));
+    if(algorithm.islandLink) printf("Island %u migrants sent: %u, received: %u\n", settings.islandId, algorithm.islandLink->sent.load(), algorithm.islandLink->received.load());
+    const Solution* solution = algorithm.incumbent.getSolution();
+    if(!solution)
+    {
+        std::cerr << "No solution found" << std::endl;
+        return 1;
+    }
+    std::cout << solution->toString() << std::endl;
 
     return 0;
 }
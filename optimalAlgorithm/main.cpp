@@ -3,22 +3,22 @@
 #include <random>
 #include <algorithm>
 #include <vector>
-#include <map>
-#include <list>
+#include <deque>
+#include <numeric>
+#include <cstdint>
+#include <new>
 #include <cstdlib>
 #include <fstream>
 #include <optional>
 #include <iostream>
 #include <queue>
+#include <limits>
+#include <string>
 
 using Json = nlohmann::json;
 
-struct ProblemInstance;
-
 namespace utils
 {
-    ProblemInstance *settings;
-
     enum MachineNumber
     {
         MACHINE1,
@@ -30,6 +30,89 @@ namespace utils
         OPERATION,
         MAINTENANCE
     };
+
+    // Allocates storage aligned to Alignment bytes so arrays can be read with aligned vector loads
+    template <typename T, std::size_t Alignment>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+        template <typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        AlignedAllocator() = default;
+        template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment> &) {}
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* pointer, std::size_t)
+        {
+            ::operator delete(pointer, std::align_val_t(Alignment));
+        }
+
+        template <typename U> bool operator == (const AlignedAllocator<U, Alignment> &) const { return true; }
+        template <typename U> bool operator != (const AlignedAllocator<U, Alignment> &) const { return false; }
+    };
+
+    using LengthArray = std::vector<unsigned int, AlignedAllocator<unsigned int, 64>>;
+
+    // xoshiro256++ (Blackman, Vigna), a UniformRandomBitGenerator that is much cheaper than std::mt19937.
+    // jump() advances the state by 2^128 draws, generators split off one seed with jump() never overlap.
+    class Xoshiro256PlusPlus
+    {
+        std::uint64_t state[4];
+
+        static std::uint64_t rotl(std::uint64_t x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        using result_type = std::uint64_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        explicit Xoshiro256PlusPlus(std::uint64_t seed)
+        {
+            // splitmix64 expands the seed so that close seeds give unrelated states
+            for (auto &&word : state)
+            {
+                seed += 0x9e3779b97f4a7c15;
+                std::uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        result_type operator()()
+        {
+            const std::uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+            const std::uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+            return result;
+        }
+
+        void jump()
+        {
+            static constexpr std::uint64_t polynomial[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+            std::uint64_t jumped[4] = { 0, 0, 0, 0 };
+            for (auto &&word : polynomial)
+                for (int bit = 0; bit < 64; ++bit)
+                {
+                    if(word & (std::uint64_t(1) << bit))
+                        for (int i = 0; i < 4; ++i) jumped[i] ^= state[i];
+                    (*this)();
+                }
+            std::copy(jumped, jumped + 4, state);
+        }
+    };
 }
 
 struct Task
@@ -37,31 +120,11 @@ struct Task
     unsigned int taskNumber = 0;
     unsigned int machine1OperationLength = 0;
     unsigned int machine2OperationLength = 0;
-    std::map<utils::MachineNumber, unsigned int> machineLengthMap = { {utils::MACHINE1, machine1OperationLength}, {utils::MACHINE2, machine2OperationLength} };
 
     Task(const unsigned int taskNumber, const unsigned int machine1OperationLength, const unsigned int machine2OperationLength)
     :taskNumber(taskNumber), machine1OperationLength(machine1OperationLength), machine2OperationLength(machine2OperationLength) {}
 };
 
-struct ProblemInstance
-{
-    unsigned int maintenanceLength;
-    unsigned int maintenancePeriod;
-    unsigned int neighbourSearchCount;
-    unsigned int algorithmRetries;
-    unsigned int candidateListSize = 5;
-    unsigned int tabuListSize = 4;
-    float operationRenewPunishmentFactor;
-    std::vector<Task> tasks;
-
-    ProblemInstance(unsigned int maintenanceLength, unsigned int maintenancePeriod, unsigned int neighbourSearchCount, unsigned int algorithmRetries, float operationRenewPunishmentFactor, const std::vector<Task> &tasks)
-    :maintenanceLength(maintenanceLength), maintenancePeriod(maintenancePeriod), neighbourSearchCount(neighbourSearchCount), algorithmRetries(algorithmRetries), tasks(tasks)
-    {
-        assert( 0 < operationRenewPunishmentFactor && operationRenewPunishmentFactor < 1 );
-        this->operationRenewPunishmentFactor = operationRenewPunishmentFactor;
-    }
-};
-
 struct MachineBlock
 {
     unsigned int start = 0;
@@ -82,16 +145,136 @@ struct MachineBlock
     }
 };
 
+using BlockIndex = std::uint32_t;
+using BlockOrder = std::vector<BlockIndex>;
+
+struct ProblemInstance
+{
+    unsigned int maintenanceLength;
+    unsigned int maintenancePeriod;
+    unsigned int neighbourSearchCount;
+    unsigned int algorithmRetries;
+    unsigned int candidateListSize = 5;
+    unsigned int tabuListSize = 4;
+    // runs with the same seed are identical, a random one is drawn when it is not given
+    std::optional<std::uint64_t> seed;
+    float operationRenewPunishmentFactor;
+    std::vector<Task> tasks;
+    // operationLengths[machineNumber][i] is the length of the operation of tasks[i] on that machine
+    utils::LengthArray operationLengths[2];
+    // every operation of the instance, tasks[i] owns blocks 2i (machine 1) and 2i + 1 (machine 2)
+    std::vector<MachineBlock> blocks;
+    // taskNumber -> position in tasks
+    std::vector<unsigned int> taskPositions;
+
+    ProblemInstance(unsigned int maintenanceLength, unsigned int maintenancePeriod, unsigned int neighbourSearchCount, unsigned int algorithmRetries, float operationRenewPunishmentFactor, std::vector<Task> tasks)
+    :maintenanceLength(maintenanceLength), maintenancePeriod(maintenancePeriod), neighbourSearchCount(neighbourSearchCount), algorithmRetries(algorithmRetries), tasks(std::move(tasks))
+    {
+        assert( 0 < operationRenewPunishmentFactor && operationRenewPunishmentFactor < 1 );
+        this->operationRenewPunishmentFactor = operationRenewPunishmentFactor;
+
+        operationLengths[utils::MACHINE1].resize(this->tasks.size());
+        operationLengths[utils::MACHINE2].resize(this->tasks.size());
+        for (unsigned int position = 0; position < this->tasks.size(); ++position)
+        {
+            operationLengths[utils::MACHINE1][position] = this->tasks[position].machine1OperationLength;
+            operationLengths[utils::MACHINE2][position] = this->tasks[position].machine2OperationLength;
+        }
+
+        blocks.reserve(this->tasks.size() * 2);
+        for (unsigned int position = 0; position < this->tasks.size(); ++position)
+        {
+            const Task &task = this->tasks[position];
+            MachineBlock block1, block2;
+            block1.blockType = utils::OPERATION;
+            block1.machineNumber = utils::MACHINE1;
+            block1.length = operationLengths[utils::MACHINE1][position];
+            block1.taskNumber = task.taskNumber;
+
+            block2.blockType = utils::OPERATION;
+            block2.machineNumber = utils::MACHINE2;
+            block2.length = operationLengths[utils::MACHINE2][position];
+            block2.taskNumber = task.taskNumber;
+
+            blocks.push_back(block1);
+            blocks.push_back(block2);
+            if(task.taskNumber >= taskPositions.size()) taskPositions.resize(task.taskNumber + 1);
+            taskPositions[task.taskNumber] = position;
+        }
+    }
+
+    BlockIndex getBlockIndex(const MachineBlock &operation) const
+    {
+        return 2 * taskPositions[operation.taskNumber] + operation.machineNumber;
+    }
+};
+
+// pair of blocks on the same machine exchanging their positions in an order
+using BlockSwap = std::pair<BlockIndex, BlockIndex>;
+
+struct MachineTail
+{
+    unsigned int lastOperationEnd = 0;
+    unsigned int lastMaintenanceEnd = 0;
+};
+
 struct Solution
 {
     std::vector<MachineBlock> machine1;
     std::vector<MachineBlock> machine2;
+    MachineTail machine1Tail;
+    MachineTail machine2Tail;
+    unsigned int cMax = 0;
+    // taskNumber -> index of the task's operation in machine1/machine2, NO_SLOT if not placed yet
+    std::vector<int> machine1TaskSlots;
+    std::vector<int> machine2TaskSlots;
+    static constexpr int NO_SLOT = -1;
+    const ProblemInstance* settings;
+
+    Solution(const ProblemInstance &settings):settings(&settings){}
 
     std::vector<MachineBlock>* getMachine(utils::MachineNumber machineNumber)
     {
        return machineNumber == utils::MACHINE1 ?  &machine1 : &machine2;
     }
 
+    MachineTail* getMachineTail(utils::MachineNumber machineNumber)
+    {
+       return machineNumber == utils::MACHINE1 ?  &machine1Tail : &machine2Tail;
+    }
+
+    std::vector<int>* getMachineTaskSlots(utils::MachineNumber machineNumber)
+    {
+       return machineNumber == utils::MACHINE1 ?  &machine1TaskSlots : &machine2TaskSlots;
+    }
+
+    void clear()
+    {
+        machine1.clear();
+        machine2.clear();
+        machine1Tail = MachineTail();
+        machine2Tail = MachineTail();
+        cMax = 0;
+        std::fill(machine1TaskSlots.begin(), machine1TaskSlots.end(), NO_SLOT);
+        std::fill(machine2TaskSlots.begin(), machine2TaskSlots.end(), NO_SLOT);
+    }
+
+    void pushBlock(const MachineBlock &block)
+    {
+        auto machine = getMachine(block.machineNumber);
+        machine->push_back(block);
+        MachineTail* tail = getMachineTail(block.machineNumber);
+        if(block.blockType == utils::OPERATION)
+        {
+            auto slots = getMachineTaskSlots(block.machineNumber);
+            if(block.taskNumber >= slots->size()) slots->resize(block.taskNumber + 1, NO_SLOT);
+            (*slots)[block.taskNumber] = machine->size() - 1;
+            tail->lastOperationEnd = block.end;
+            cMax = std::max(cMax, block.end);
+        }
+        else tail->lastMaintenanceEnd = block.end;
+    }
+
     std::string toString()
     {
         std::string output;
@@ -114,24 +297,25 @@ struct Solution
         return output;
     }
 
-    Solution& randomSolution(std::list<MachineBlock> blocks)
+    Solution& randomSolution(const BlockOrder &order)
     {
+        std::deque<BlockIndex> blocks(order.begin(), order.end());
         while (!blocks.empty())
         {
-            MachineBlock candidate = blocks.front();
+            BlockIndex index = blocks.front();
+            MachineBlock candidate = settings->blocks[index];
             blocks.pop_front();
-            isBlockValidToPutOnMachine(candidate) ? addBlockToMachine(candidate) : blocks.push_back(candidate);
+            isBlockValidToPutOnMachine(candidate) ? addBlockToMachine(candidate) : blocks.push_back(index);
         }
 
         return *this;        
     }
 
-    Solution& orderedSolution(std::list<MachineBlock> blocks)
+    Solution& orderedSolution(const BlockOrder &order)
     {
-        while(!blocks.empty())
+        for (auto &&index : order)
         {
-            MachineBlock candidate = blocks.front();
-            blocks.pop_front();
+            MachineBlock candidate = settings->blocks[index];
             addOrderedBlockToMachine(candidate);
         }
         return *this;
@@ -156,10 +340,10 @@ struct Solution
 
         utils::MachineNumber machineNumberToSearch = (operation.machineNumber == utils::MACHINE1) ? utils::MACHINE2 : utils::MACHINE1;
         auto machineToSearch = getMachine(machineNumberToSearch);
+        auto slots = getMachineTaskSlots(machineNumberToSearch);
 
-        auto itCorrespondingOperation = std::find_if(machineToSearch->begin(), machineToSearch->end(),[&](MachineBlock &x){ return x.taskNumber == operation.taskNumber; });
-        if(itCorrespondingOperation != machineToSearch->end())
-            return std::optional<MachineBlock*>(&(*itCorrespondingOperation));
+        if(operation.taskNumber < slots->size() && (*slots)[operation.taskNumber] != NO_SLOT)
+            return std::optional<MachineBlock*>(&(*machineToSearch)[(*slots)[operation.taskNumber]]);
         else return std::nullopt;
     }
 
@@ -184,13 +368,13 @@ struct Solution
             {
                 candidate.start = 0;
                 candidate.end = candidate.length;
-                machine->push_back(candidate);
+                pushBlock(candidate);
             }
             else
             {
                 candidate.start = machine->back().end;
                 candidate.end = candidate.start + candidate.length;
-                machine->push_back(candidate);
+                pushBlock(candidate);
             }
         }
         else
@@ -198,11 +382,11 @@ struct Solution
              MachineBlock maintenance;
              maintenance.blockType = utils::MAINTENANCE;
              maintenance.start = machine->back().end;
-             maintenance.length = utils::settings->maintenanceLength;
+             maintenance.length = settings->maintenanceLength;
              maintenance.end = maintenance.start + maintenance.length;
              maintenance.machineNumber = candidate.machineNumber;
 
-             machine->push_back(maintenance);
+             pushBlock(maintenance);
              return addBlockToMachine(candidate);
         }
     }
@@ -221,13 +405,13 @@ struct Solution
                 {
                     candidate.start = 0;
                     candidate.end = candidate.length;
-                    machine->push_back(candidate);
+                    pushBlock(candidate);
                 }
                 else
                 {
                     candidate.start = machine->back().end;
                     candidate.end = candidate.start + candidate.length;
-                    machine->push_back(candidate);
+                    pushBlock(candidate);
                 }
             }
             else
@@ -238,18 +422,18 @@ struct Solution
                 {
                     candidate.start = correspondingOperation->end;
                     candidate.end = candidate.length + candidate.start;
-                    machine->push_back(candidate);
+                    pushBlock(candidate);
                 }
                 else
                 {
                     MachineBlock maintenance;
                     maintenance.blockType = utils::MAINTENANCE;
                     maintenance.start = machine->back().end;
-                    maintenance.length = utils::settings->maintenanceLength;
+                    maintenance.length = settings->maintenanceLength;
                     maintenance.end = maintenance.start + maintenance.length;
                     maintenance.machineNumber = candidate.machineNumber;
 
-                    machine->push_back(maintenance);
+                    pushBlock(maintenance);
                     return addOrderedBlockToMachine(candidate);
                 }
                 
@@ -260,11 +444,11 @@ struct Solution
              MachineBlock maintenance;
              maintenance.blockType = utils::MAINTENANCE;
              maintenance.start = machine->back().end;
-             maintenance.length = utils::settings->maintenanceLength;
+             maintenance.length = settings->maintenanceLength;
              maintenance.end = maintenance.start + maintenance.length;
              maintenance.machineNumber = candidate.machineNumber;
 
-             machine->push_back(maintenance);
+             pushBlock(maintenance);
              return addOrderedBlockToMachine(candidate);
         }
     }
@@ -280,41 +464,23 @@ struct Solution
 
     unsigned int getTimeToNextMaintenance(utils::MachineNumber &machineNumber)
     {
-        auto lastMaintenance = getLastMachineBlock(machineNumber, utils::MAINTENANCE);
-        auto lastOperation = getLastMachineBlock(machineNumber, utils::OPERATION);
-        unsigned int lastMaintenanceEndTime = lastMaintenance.has_value() ? lastMaintenance.value().end : 0;
-        unsigned int lastOperationEndTime = lastOperation.has_value() ? lastOperation.value().end : 0;
+        MachineTail* tail = getMachineTail(machineNumber);
+        unsigned int lastMaintenanceEndTime = tail->lastMaintenanceEnd;
+        unsigned int lastOperationEndTime = tail->lastOperationEnd;
 
-        return utils::settings->maintenancePeriod - abs(lastOperationEndTime - lastMaintenanceEndTime);
+        return settings->maintenancePeriod - abs(lastOperationEndTime - lastMaintenanceEndTime);
     }
     unsigned int getTimeToNextMaintenance(MachineBlock &candidate)
     {
-        auto lastMaintenance = getLastMachineBlock(candidate.machineNumber, utils::MAINTENANCE);
-        unsigned int lastMaintenanceEndTime = lastMaintenance.has_value() ? lastMaintenance.value().end : 0;
+        unsigned int lastMaintenanceEndTime = getMachineTail(candidate.machineNumber)->lastMaintenanceEnd;
         unsigned int lastOperationEndTime = candidate.start;
 
-        return utils::settings->maintenancePeriod - abs(lastOperationEndTime - lastMaintenanceEndTime);
+        return settings->maintenancePeriod - abs(lastOperationEndTime - lastMaintenanceEndTime);
     }
 
     unsigned int getCmax()
     {
-        auto compareEndTime = [](const MachineBlock& x, const MachineBlock& y){ return x.end < y.end; };
-        auto lastM1operation = getLastMachineBlock(utils::MACHINE1, utils::OPERATION);
-        auto lastM1operationValue = lastM1operation.value();
-        auto lastM2operation = getLastMachineBlock(utils::MACHINE2, utils::OPERATION);
-        auto lastM2operationValue = lastM2operation.value();
-        auto lastOperation = std::max(lastM1operationValue, lastM2operationValue, compareEndTime);
-        return lastOperation.end;
-    }
-
-    std::optional<MachineBlock> getLastMachineBlock(const utils::MachineNumber &machine, const utils::BlockType &block)
-    {
-        auto machineToSearch = machine == utils::MACHINE1 ? machine1 : machine2;
-        auto it = std::find_if(machineToSearch.rbegin(), machineToSearch.rend(), [&](MachineBlock &x){ return x.blockType == block;});
-        if (it != machineToSearch.rend())
-            return std::optional<MachineBlock>(*it);
-        else
-            return std::nullopt;
+        return cMax;
     }
 };
 
@@ -324,74 +490,65 @@ struct Node
     Solution solution; 
 }; 
 
+template <typename RandomGenerator = utils::Xoshiro256PlusPlus>
 class OptimalSearch
 {
 private:
-    std::random_device rd;
-    std::mt19937 randomGenerator;
-    ProblemInstance* settings;
+    RandomGenerator randomGenerator;
+    const ProblemInstance* settings;
     
 public:
     Solution bestSolution;
     Solution currentSolution;
     unsigned int bestCmax;
-    OptimalSearch(ProblemInstance &settings):settings(&settings), randomGenerator(rd()){}
-
-    std::list<MachineBlock> createRandomOrder()
-    {   
-        unsigned int numberOfMachines = 2;
-        std::vector<MachineBlock> tmpVector;
-        for (auto &&task : settings->tasks)
-        {
-            MachineBlock block1, block2;
-            block1.blockType = utils::OPERATION;
-            block1.machineNumber = utils::MACHINE1;
-            block1.length = task.machineLengthMap[utils::MACHINE1];
-            block1.taskNumber = task.taskNumber;
+    OptimalSearch(const ProblemInstance &settings, const RandomGenerator &randomGenerator):randomGenerator(randomGenerator), settings(&settings), bestSolution(settings), currentSolution(settings){}
 
-            block2.blockType = utils::OPERATION;
-            block2.machineNumber = utils::MACHINE2;
-            block2.length = task.machineLengthMap[utils::MACHINE2];
-            block2.taskNumber = task.taskNumber;
-            
-            tmpVector.push_back(block1);
-            tmpVector.push_back(block2);
-        }
-        std::shuffle(tmpVector.begin(), tmpVector.end(), randomGenerator);
-        std::list<MachineBlock> machineBlockList(tmpVector.begin(), tmpVector.end());
-        return machineBlockList;
+    BlockOrder createRandomOrder()
+    {
+        // one block per operation length of either machine
+        BlockOrder order(settings->operationLengths[utils::MACHINE1].size() + settings->operationLengths[utils::MACHINE2].size());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), randomGenerator);
+        return order;
     }
 
-    std::list<MachineBlock> getBlocksOrder(Solution &solution)
+    BlockOrder getBlocksOrder(Solution &solution)
     {
-        std::vector<MachineBlock> tmpVector;
-        tmpVector.insert(tmpVector.end(), solution.machine1.begin(), solution.machine1.end());
-        tmpVector.insert(tmpVector.end(), solution.machine2.begin(), solution.machine2.end());
-        std::list<MachineBlock> blocks(tmpVector.begin(), tmpVector.end());
+        BlockOrder order;
+        order.reserve(settings->blocks.size());
+        for (auto &&block : solution.machine1)
+            if(block.blockType == utils::OPERATION) order.push_back(settings->getBlockIndex(block));
+        for (auto &&block : solution.machine2)
+            if(block.blockType == utils::OPERATION) order.push_back(settings->getBlockIndex(block));
+        return order;
+    }
 
-        blocks.remove_if([](MachineBlock x){return x.blockType == utils::MAINTENANCE;});
-        std::for_each(blocks.begin(), blocks.end(), [](MachineBlock &x){ x.start = 0; x.end = 0;});
-        return blocks;
+    // blockIndex -> position of the block in order
+    std::vector<unsigned int> getBlockPositions(const BlockOrder &order)
+    {
+        std::vector<unsigned int> positions(order.size());
+        for (unsigned int position = 0; position < order.size(); ++position)
+            positions[order[position]] = position;
+        return positions;
     }
 
     OptimalSearch& createInitialSolution()
     {
-        currentSolution.machine1.clear();
-        currentSolution.machine2.clear();
-        std::list<MachineBlock> blocks = this->createRandomOrder();
+        currentSolution.clear();
+        BlockOrder blocks = this->createRandomOrder();
         currentSolution.randomSolution(blocks);
         return *this;
     }
 
-    std::vector<std::pair<MachineBlock, MachineBlock>> generateCandidatesForSwap(std::list<MachineBlock> &blocks)
+    std::vector<BlockSwap> generateCandidatesForSwap(const BlockOrder &blocks)
     {
-        unsigned int candidatesCount = utils::settings->neighbourSearchCount;
-        std::vector<std::pair<MachineBlock, MachineBlock>> swapCandidates;
+        unsigned int candidatesCount = settings->neighbourSearchCount;
+        std::vector<BlockSwap> swapCandidates;
         swapCandidates.reserve(candidatesCount);
 
         do
         {
-            std::pair<MachineBlock, MachineBlock> swap = getRandomSwap(blocks);
+            BlockSwap swap = getRandomSwap(blocks);
             if(isSwapCandidateInSwapList(swap, swapCandidates)) continue;
             else swapCandidates.push_back(swap);
         }
@@ -400,30 +557,28 @@ public:
         return swapCandidates;
     }
 
-    std::pair<MachineBlock, MachineBlock> getRandomSwap(const std::list<MachineBlock> &blocks)
+    BlockSwap getRandomSwap(const BlockOrder &blocks)
     {
-        std::vector<MachineBlock> tempVector(blocks.begin(), blocks.end());
+        BlockOrder tempVector(blocks);
         std::shuffle(tempVector.begin(), tempVector.end(), randomGenerator);
-        MachineBlock first = tempVector.back();
+        BlockIndex first = tempVector.back();
         tempVector.pop_back();
-        auto it = std::find_if(tempVector.begin(), tempVector.end(), [&](MachineBlock &x){ return x.machineNumber == first.machineNumber;});
+        auto machineNumber = settings->blocks[first].machineNumber;
+        auto it = std::find_if(tempVector.begin(), tempVector.end(), [&](BlockIndex x){ return settings->blocks[x].machineNumber == machineNumber;});
         assert(it != tempVector.end());
-        MachineBlock second = *it;
+        BlockIndex second = *it;
         return std::make_pair(first, second);
     }
 
-    bool isSwapCandidateInSwapList(std::pair<MachineBlock, MachineBlock> swap,const std::vector<std::pair<MachineBlock, MachineBlock>> &swapList)
+    bool isSwapCandidateInSwapList(const BlockSwap &swap, const std::vector<BlockSwap> &swapList)
     {
-        return std::any_of(swapList.begin(), swapList.end(), [&](std::pair<MachineBlock, MachineBlock> x){ return x == swap;});
+        return std::any_of(swapList.begin(), swapList.end(), [&](const BlockSwap &x){ return (x.first == swap.first && x.second == swap.second) || (x.first == swap.second && x.second == swap.first);});
     }
 
-    std::list<MachineBlock> swap(std::pair<MachineBlock, MachineBlock> &pair, std::list<MachineBlock> list)
+    void swap(const BlockSwap &swap, BlockOrder &order, std::vector<unsigned int> &positions)
     {
-        auto it1 = std::find(list.begin(), list.end(), pair.first);
-        auto it2 = std::find(list.begin(), list.end(), pair.second);
-        assert(it1 != list.end() && it2 != list.end());
-        std::swap(*it1, *it2);
-        return list;
+        std::swap(order[positions[swap.first]], order[positions[swap.second]]);
+        std::swap(positions[swap.first], positions[swap.second]);
     }
 
     float calculateSD(std::vector<int> &localCmaxs)
@@ -440,23 +595,22 @@ public:
         return sqrt(standardDeviation / localCmaxs.size());
     }
 
-    void fullSearch(std::vector<MachineBlock> sortedOrder)
+    void fullSearch(BlockOrder sortedOrder)
     {
         unsigned long long int count = 1;
+        auto compareBlocks = [&](BlockIndex x, BlockIndex y){ return settings->blocks[x] < settings->blocks[y]; };
         do
         {
-            std::list<MachineBlock> tempList(sortedOrder.begin(), sortedOrder.end());
-            currentSolution.orderedSolution(tempList);
+            currentSolution.orderedSolution(sortedOrder);
             unsigned int currentCmax = currentSolution.getCmax();
             if(currentCmax < bestCmax) 
             {
                 bestSolution = currentSolution;
                 bestCmax = currentCmax;
             }
-            currentSolution.machine1.clear();
-            currentSolution.machine2.clear();
+            currentSolution.clear();
             std::cout << "\r" << count++;
-        } while (std::next_permutation(sortedOrder.begin(), sortedOrder.end()));
+        } while (std::next_permutation(sortedOrder.begin(), sortedOrder.end(), compareBlocks));
         std::cout << "\n";
     }
 
@@ -467,13 +621,32 @@ ProblemInstance loadProblemInstance(const char* filepath)
     std::ifstream file(filepath);
     Json jsonParser;
     file >> jsonParser;
+    const Json &jsonTasks = jsonParser["tasks"];
     std::vector<Task> tasks;
-    tasks.reserve(jsonParser.size());
-    for (auto && task: jsonParser["tasks"].items())
-        tasks.push_back(Task(std::strtoul(task.key().c_str(), NULL, 10), task.value()["1"], task.value()["2"]));
+    tasks.reserve(jsonTasks.size());
+    for (auto && task: jsonTasks.items())
+        tasks.emplace_back(std::strtoul(task.key().c_str(), NULL, 10), task.value()["1"].get<unsigned int>(), task.value()["2"].get<unsigned int>());
+
+    ProblemInstance instance(jsonParser["maintenanceLength"], jsonParser["maintenancePeriod"], jsonParser["neighbourSearchCount"],
+        jsonParser["algorithmRetries"], jsonParser["operationRenewPunishmentFactor"], std::move(tasks));
+    if(jsonParser.contains("seed")) instance.seed = jsonParser["seed"].get<std::uint64_t>();
+    return instance;
+}
 
-    return ProblemInstance(jsonParser["maintenanceLength"], jsonParser["maintenancePeriod"], jsonParser["neighbourSearchCount"],
-        jsonParser["algorithmRetries"], jsonParser["operationRenewPunishmentFactor"], tasks);
+// Options given after the instance path override the values from the instance file
+void applyCommandLineOptions(ProblemInstance &settings, int argc, char const *argv[])
+{
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if(option == "--seed" && i + 1 < argc) settings.seed = std::strtoull(argv[++i], NULL, 10);
+        else std::cerr << "Unknown option: " << option << std::endl;
+    }
+    if(!settings.seed)
+    {
+        std::random_device rd;
+        settings.seed = (std::uint64_t(rd()) << 32) | rd();
+    }
 }
 
 
@@ -481,15 +654,15 @@ int main(int argc, char const *argv[])
 {
     const char* filepath = argv[1];
     ProblemInstance settings = loadProblemInstance(filepath);
-    utils::settings = &settings;
-    OptimalSearch algorithm(settings);
+    applyCommandLineOptions(settings, argc, argv);
+    printf("Seed: %llu\n", static_cast<unsigned long long>(*settings.seed));
+    OptimalSearch<> algorithm(settings, utils::Xoshiro256PlusPlus(*settings.seed));
     algorithm.createInitialSolution();
     algorithm.bestSolution = algorithm.currentSolution;
     algorithm.bestCmax = algorithm.bestSolution.getCmax();
-    auto order = algorithm.createRandomOrder();
-    std::vector<MachineBlock> vectorInitialOrder(order.begin(), order.end());
-    std::sort(vectorInitialOrder.begin(), vectorInitialOrder.end());
-    algorithm.fullSearch(vectorInitialOrder);
+    BlockOrder order = algorithm.createRandomOrder();
+    std::sort(order.begin(), order.end(), [&](BlockIndex x, BlockIndex y){ return settings.blocks[x] < settings.blocks[y]; });
+    algorithm.fullSearch(order);
     std::cout << algorithm.bestSolution.toString() << std::endl;
 
     return 0;